@@ -0,0 +1,240 @@
+"""
+Scaling benchmark for the patrol swarm scenarios.
+
+Sweeps swarm size, formation spacing, heartbeat interval and attack
+scenario over the manet_swarm_suite binary, one process per
+configuration. Each run writes a --profile record (sim_profiler.h) with
+wall time, events per second, peak RSS and the network metrics, which
+are collected into one CSV and printed as scaling curves per series.
+Every size uses a generated formation (--shape, hex by default), so the
+swarm keeps the same density as it grows.
+
+Runs are sequential by default so wall times are comparable; a
+configuration that exceeds --timeout is recorded as such and larger
+swarms of the same series are skipped, which marks where the
+single-threaded setup breaks down.
+
+With --compare, wall time and events/s are checked against an earlier
+CSV and the script exits non-zero when any configuration regressed by
+more than --tolerance.
+
+Usage:
+    python3 bench_swarm_scaling.py --ns3-dir ~/ns-3-dev --csv scaling.csv
+    python3 bench_swarm_scaling.py --ns3-dir ~/ns-3-dev --nodes 7,30,125 \\
+        --compare scaling.csv --tolerance 0.2
+"""
+
+import argparse
+import csv
+import itertools
+import json
+import math
+import os
+import subprocess
+import sys
+import tempfile
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+from run_replications import find_binary
+
+FIELDS = ["scenario", "nNodes", "formationScale", "heartbeatInterval", "status",
+          "wall", "wallRun", "events", "eventsPerSecond", "peakRssKb",
+          "pdr", "avgDelay", "throughputKbps"]
+
+
+def float_list(text):
+    return [float(v) for v in text.split(",") if v]
+
+
+def int_list(text):
+    return [int(v) for v in text.split(",") if v]
+
+
+def run_config(binary, config, extra_args, workdir, timeout):
+    """
+    Run one configuration and return its row.
+    """
+    scenario, nodes, scale, interval = config
+    name = "%s_n%d_s%g_i%g" % (scenario, nodes, scale, interval)
+    rundir = os.path.join(workdir, name)
+    os.makedirs(rundir, exist_ok=True)
+
+    profile = os.path.join(rundir, "profile.jsonl")
+    if os.path.exists(profile):
+        os.remove(profile)
+
+    cmd = [binary,
+           "--scenarios=%s" % scenario,
+           "--nNodes=%d" % nodes,
+           "--formationScale=%g" % scale,
+           "--heartbeatInterval=%g" % interval,
+           "--profile=%s" % profile] + extra_args
+
+    row = {"scenario": scenario, "nNodes": nodes,
+           "formationScale": scale, "heartbeatInterval": interval}
+
+    start = time.time()
+    try:
+        proc = subprocess.run(cmd, cwd=rundir, capture_output=True,
+                              text=True, timeout=timeout)
+    except subprocess.TimeoutExpired:
+        row["status"] = "timeout"
+        row["wall"] = time.time() - start
+        return row
+    row["wall"] = time.time() - start
+
+    if proc.returncode != 0:
+        row["status"] = "failed"
+        print("[WARN] %s exited with %d:\n%s"
+              % (name, proc.returncode, proc.stderr[-2000:]), file=sys.stderr)
+        return row
+
+    with open(profile) as f:
+        record = json.loads(f.readline())
+
+    row["status"] = "ok"
+    row["wallRun"] = record["phases"].get("run")
+    for key in ("events", "eventsPerSecond", "peakRssKb",
+                "pdr", "avgDelay", "throughputKbps"):
+        row[key] = record.get(key)
+    return row
+
+
+def series_key(row):
+    return (row["scenario"], row["formationScale"], row["heartbeatInterval"])
+
+
+def print_curves(rows):
+    """
+    One table per series, nodes ascending, with the local log-log slope
+    of run wall time against swarm size (1 = linear, 2 = quadratic).
+    """
+    series = {}
+    for row in rows:
+        series.setdefault(series_key(row), []).append(row)
+
+    for key in sorted(series):
+        points = sorted(series[key], key=lambda r: r["nNodes"])
+        print("\n===== %s  scale=%g  interval=%g s =====" % key)
+        print("%7s %10s %12s %9s %8s %10s %8s"
+              % ("nodes", "run (s)", "events/s", "RSS (MB)", "PDR (%)", "delay (s)", "slope"))
+
+        prev = None
+        for r in points:
+            if r["status"] != "ok":
+                print("%7d %10s" % (r["nNodes"], r["status"]))
+                continue
+
+            slope = ""
+            if prev and prev["wallRun"] > 0 and r["wallRun"] > 0:
+                slope = "%.2f" % (math.log(r["wallRun"] / prev["wallRun"]) /
+                                  math.log(r["nNodes"] / prev["nNodes"]))
+            print("%7d %10.3f %12.0f %9.1f %8.2f %10.4f %8s"
+                  % (r["nNodes"], r["wallRun"], r["eventsPerSecond"],
+                     r["peakRssKb"] / 1024.0, r["pdr"], r["avgDelay"], slope))
+            prev = r
+
+
+def compare(rows, baseline_csv, tolerance):
+    """
+    Flag configurations whose run wall time grew, or whose event rate
+    dropped, by more than tolerance relative to the baseline CSV.
+    """
+    with open(baseline_csv, newline="") as f:
+        old = {(r["scenario"], int(r["nNodes"]), float(r["formationScale"]),
+                float(r["heartbeatInterval"])): r
+               for r in csv.DictReader(f) if r["status"] == "ok"}
+
+    regressions = 0
+    for row in rows:
+        key = (row["scenario"], row["nNodes"], row["formationScale"], row["heartbeatInterval"])
+        ref = old.get(key)
+        if ref is None:
+            continue
+        if row["status"] != "ok":
+            print("[REGRESSION] %s %s (was ok)" % (key, row["status"]))
+            regressions += 1
+            continue
+
+        wall_ratio = row["wallRun"] / float(ref["wallRun"])
+        rate_ratio = row["eventsPerSecond"] / float(ref["eventsPerSecond"])
+        if wall_ratio > 1 + tolerance or rate_ratio < 1 - tolerance:
+            print("[REGRESSION] %s run %.3f s -> %.3f s, events/s %.0f -> %.0f"
+                  % (key, float(ref["wallRun"]), row["wallRun"],
+                     float(ref["eventsPerSecond"]), row["eventsPerSecond"]))
+            regressions += 1
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--program", default="manet_swarm_suite", help="scratch program name")
+    parser.add_argument("--binary", help="path to a built suite binary (overrides --program)")
+    parser.add_argument("--ns3-dir", default=os.environ.get("NS3_DIR", "."),
+                        help="ns-3 source tree containing build/ (default: $NS3_DIR or .)")
+    parser.add_argument("--nodes", type=int_list, default=[7, 15, 30, 60, 125, 250, 500, 1000],
+                        help="comma-separated swarm sizes")
+    parser.add_argument("--shape", default="hex",
+                        help="generated formation shape (empty: built-in tables)")
+    parser.add_argument("--spacing", type=float_list, default=[1.0, 2.0],
+                        help="comma-separated formation scale factors")
+    parser.add_argument("--interval", type=float_list, default=[2.0, 0.5],
+                        help="comma-separated heartbeat intervals (s)")
+    parser.add_argument("--scenarios", default="baseline,blackhole,grayhole",
+                        help="comma-separated scenarios (attack modes)")
+    parser.add_argument("--jobs", type=int, default=1,
+                        help="parallel processes (>1 skews wall times)")
+    parser.add_argument("--timeout", type=float, default=1800, help="per-run timeout (s)")
+    parser.add_argument("--workdir", help="keep per-run outputs here instead of a temp dir")
+    parser.add_argument("--csv", help="write all rows to this CSV file")
+    parser.add_argument("--compare", help="earlier CSV to check for regressions")
+    parser.add_argument("--tolerance", type=float, default=0.2,
+                        help="allowed relative slowdown for --compare")
+    parser.add_argument("args", nargs="*", help="extra arguments passed to every run")
+    opts = parser.parse_args()
+
+    binary = os.path.abspath(opts.binary) if opts.binary else find_binary(opts.ns3_dir, opts.program)
+    workdir = opts.workdir or tempfile.mkdtemp(prefix="manet_scaling_")
+
+    scenarios = [s for s in opts.scenarios.split(",") if s]
+    series = list(itertools.product(scenarios, opts.spacing, opts.interval))
+    nodes = sorted(opts.nodes)
+    extra = (["--formationShape=%s" % opts.shape] if opts.shape else []) + opts.args
+
+    print("Benchmarking %d series x %d sizes with %s (outputs in %s)"
+          % (len(series), len(nodes), os.path.basename(binary), workdir))
+
+    def run_series(s):
+        # Ascending sizes; stop the series at the first timeout
+        out = []
+        for n in nodes:
+            row = run_config(binary, (s[0], n, s[1], s[2]), extra, workdir, opts.timeout)
+            out.append(row)
+            print("[INFO] %s n=%d scale=%g interval=%g: %s %.1f s"
+                  % (s[0], n, s[1], s[2], row["status"], row["wall"]), flush=True)
+            if row["status"] == "timeout":
+                break
+        return out
+
+    with ThreadPoolExecutor(max_workers=opts.jobs) as pool:
+        rows = [row for out in pool.map(run_series, series) for row in out]
+
+    if opts.csv:
+        with open(opts.csv, "w", newline="") as f:
+            writer = csv.DictWriter(f, fieldnames=FIELDS)
+            writer.writeheader()
+            writer.writerows(rows)
+
+    print_curves(rows)
+
+    if opts.compare:
+        regressions = compare(rows, opts.compare, opts.tolerance)
+        print("\n%d regression(s) against %s" % (regressions, opts.compare))
+        return 1 if regressions else 0
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
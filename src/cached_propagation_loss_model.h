@@ -0,0 +1,216 @@
+#ifndef CACHED_PROPAGATION_LOSS_MODEL_H
+#define CACHED_PROPAGATION_LOSS_MODEL_H
+
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/propagation-module.h"
+
+#include <cmath>
+#include <iostream>
+#include <unordered_map>
+#include <utility>
+
+namespace ns3
+{
+
+/*
+ Memoized propagation loss
+ - Wraps a deterministic loss model (SetInner, log-distance by default) and
+   keeps the loss in dB per ordered (sender, receiver) mobility pair,
+   along with both endpoint positions it was computed for
+ - A lookup is a hit while neither endpoint has moved (both positions
+   within Tolerance of the cached ones). With DistanceOnly, only the
+   pair's distance has to match, so followers of a rigid formation hit
+   while the whole formation moves; valid for models that depend on
+   distance alone (log-distance, Friis, two-ray ground, ...)
+ - Loss is taken as independent of transmit power, as it is for every
+   frequency-flat model. Models with fading (Nakagami, Jakes) must not
+   be wrapped: their randomness would be frozen
+ - The model only counts lookups. The CPU time it saves is measured by
+   an A/B pair of --profile runs with and without the cache: timing a
+   ~50 ns inner call costs as much as the call, and a hit is not free
+   either (two GetPosition calls, a hash lookup, distance checks)
+*/
+class CachedPropagationLossModel : public PropagationLossModel
+{
+  public:
+    static TypeId GetTypeId();
+
+    CachedPropagationLossModel();
+
+    void SetInner(Ptr<PropagationLossModel> inner) { m_inner = inner; }
+    Ptr<PropagationLossModel> GetInner() const { return m_inner; }
+
+    uint64_t GetHits() const { return m_hits; }
+    uint64_t GetMisses() const { return m_misses; }
+    uint64_t GetInvalidations() const { return m_invalidations; }
+    double GetHitRate() const;
+    std::size_t GetEntries() const { return m_cache.size(); }
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    double DoCalcRxPower(double txPowerDbm,
+                         Ptr<MobilityModel> a,
+                         Ptr<MobilityModel> b) const override;
+    int64_t DoAssignStreams(int64_t stream) override;
+
+    struct Entry
+    {
+        Vector a;
+        Vector b;
+        double lossDb;
+    };
+
+    typedef std::pair<const MobilityModel *, const MobilityModel *> Key;
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key &k) const
+        {
+            auto a = reinterpret_cast<uintptr_t>(k.first);
+            auto b = reinterpret_cast<uintptr_t>(k.second);
+            return std::hash<uintptr_t>()(a * 0x9E3779B97F4A7C15ULL ^ b);
+        }
+    };
+
+    bool Matches(const Entry &e, const Vector &a, const Vector &b) const;
+
+    Ptr<PropagationLossModel> m_inner;
+    double m_tolerance = 0.0;
+    bool m_distanceOnly = false;
+    uint32_t m_maxEntries = 1 << 20;
+
+    // DoCalcRxPower is const in the PropagationLossModel interface
+    mutable std::unordered_map<Key, Entry, KeyHash> m_cache;
+    mutable uint64_t m_hits = 0;
+    mutable uint64_t m_misses = 0;
+    mutable uint64_t m_invalidations = 0;
+};
+
+NS_OBJECT_ENSURE_REGISTERED(CachedPropagationLossModel);
+
+inline TypeId
+CachedPropagationLossModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::CachedPropagationLossModel")
+            .SetParent<PropagationLossModel>()
+            .SetGroupName("Propagation")
+            .AddConstructor<CachedPropagationLossModel>()
+            .AddAttribute("Tolerance",
+                          "Movement (m) below which a cached entry stays valid",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&CachedPropagationLossModel::m_tolerance),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("DistanceOnly",
+                          "Validate entries by the pair's distance instead of both positions",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&CachedPropagationLossModel::m_distanceOnly),
+                          MakeBooleanChecker())
+            .AddAttribute("MaxEntries",
+                          "Pairs kept before the cache is cleared",
+                          UintegerValue(1 << 20),
+                          MakeUintegerAccessor(&CachedPropagationLossModel::m_maxEntries),
+                          MakeUintegerChecker<uint32_t>(1));
+    return tid;
+}
+
+inline
+CachedPropagationLossModel::CachedPropagationLossModel()
+    : m_inner(CreateObject<LogDistancePropagationLossModel>())
+{
+}
+
+inline void
+CachedPropagationLossModel::DoDispose()
+{
+    m_inner = nullptr;
+    m_cache.clear();
+    PropagationLossModel::DoDispose();
+}
+
+inline double
+CachedPropagationLossModel::GetHitRate() const
+{
+    uint64_t lookups = m_hits + m_misses;
+    return lookups ? 100.0 * m_hits / lookups : 0.0;
+}
+
+inline bool
+CachedPropagationLossModel::Matches(const Entry &e, const Vector &a, const Vector &b) const
+{
+    if (m_distanceOnly)
+        return std::fabs(CalculateDistance(a, b) - CalculateDistance(e.a, e.b)) <= m_tolerance;
+
+    if (m_tolerance == 0.0)
+    {
+        return a.x == e.a.x && a.y == e.a.y && a.z == e.a.z &&
+               b.x == e.b.x && b.y == e.b.y && b.z == e.b.z;
+    }
+    return CalculateDistance(a, e.a) <= m_tolerance && CalculateDistance(b, e.b) <= m_tolerance;
+}
+
+inline double
+CachedPropagationLossModel::DoCalcRxPower(double txPowerDbm,
+                                          Ptr<MobilityModel> a,
+                                          Ptr<MobilityModel> b) const
+{
+    Vector pa = a->GetPosition();
+    Vector pb = b->GetPosition();
+
+    Key key(PeekPointer(a), PeekPointer(b));
+    auto it = m_cache.find(key);
+    if (it != m_cache.end())
+    {
+        if (Matches(it->second, pa, pb))
+        {
+            ++m_hits;
+            return txPowerDbm - it->second.lossDb;
+        }
+        ++m_invalidations;
+    }
+
+    ++m_misses;
+    double rx = m_inner->CalcRxPower(txPowerDbm, a, b);
+
+    if (it != m_cache.end())
+    {
+        it->second = {pa, pb, txPowerDbm - rx};
+    }
+    else
+    {
+        if (m_cache.size() >= m_maxEntries)
+            m_cache.clear();
+        m_cache.emplace(key, Entry{pa, pb, txPowerDbm - rx});
+    }
+    return rx;
+}
+
+inline int64_t
+CachedPropagationLossModel::DoAssignStreams(int64_t stream)
+{
+    return m_inner ? m_inner->AssignStreams(stream) : 0;
+}
+
+// ----- Cache report -----
+inline void
+PrintLossCacheStats(Ptr<CachedPropagationLossModel> cache)
+{
+    if (!cache)
+        return;
+
+    std::cout << "\n===== LOSS CACHE =====\n";
+    std::cout << "Lookups: " << cache->GetHits() + cache->GetMisses() << "\n";
+    std::cout << "Hit rate: " << cache->GetHitRate() << " %\n";
+    std::cout << "Invalidations (endpoint moved): " << cache->GetInvalidations() << "\n";
+    std::cout << "Cached pairs: " << cache->GetEntries() << "\n";
+    std::cout << "Inner model computations: " << cache->GetMisses()
+              << " (CPU saved: compare --profile runs with cacheLoss on and off)\n";
+    std::cout << "======================\n";
+}
+
+} // namespace ns3
+
+#endif /* CACHED_PROPAGATION_LOSS_MODEL_H */
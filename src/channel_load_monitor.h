@@ -0,0 +1,138 @@
+#ifndef CHANNEL_LOAD_MONITOR_H
+#define CHANNEL_LOAD_MONITOR_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/wifi-module.h"
+
+#include <iostream>
+#include <sstream>
+
+namespace ns3
+{
+
+/*
+ Wi-Fi channel load and sink-node load
+ - Transmit airtime: every PHY's State trace reports each TX period
+   when it ends; durations are summed over all nodes, so the per-second
+   figure is the mean number of transmitters on the air
+ - Failed receptions: the PHY's RxError trace (frames that were
+   received but could not be decoded, i.e. collisions and low SNR)
+ - Sink load (the leader): IP packets received and sent on its
+   wireless interface, and the time its PHY spent receiving
+*/
+class ChannelLoadMonitor
+{
+  public:
+    explicit ChannelLoadMonitor(Ptr<Node> sink) : m_sink(sink) {}
+
+    // Connect to every node's Wi-Fi PHY and the sink's IP layer; call
+    // after the devices and stack are installed
+    void Install();
+
+    void PrintSummary(Time duration) const;
+
+    Time GetTxAirtime() const { return m_txAirtime; }
+    uint64_t GetRxErrors() const { return m_rxErrors; }
+    uint64_t GetSinkPacketsReceived() const { return m_sinkRxPackets; }
+
+  private:
+    void State(Time start, Time duration, WifiPhyState state);
+    void RxError(Ptr<const Packet> packet, double snr);
+    void SinkState(Time start, Time duration, WifiPhyState state);
+    void SinkRx(Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface);
+    void SinkTx(Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface);
+
+    Ptr<Node> m_sink;
+
+    Time m_txAirtime;
+    uint64_t m_txFrames = 0;
+    uint64_t m_rxErrors = 0;
+
+    Time m_sinkRxAirtime;
+    uint64_t m_sinkRxPackets = 0;
+    uint64_t m_sinkRxBytes = 0;
+    uint64_t m_sinkTxPackets = 0;
+};
+
+inline void
+ChannelLoadMonitor::Install()
+{
+    Config::ConnectWithoutContext("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/State/State",
+                                  MakeCallback(&ChannelLoadMonitor::State, this));
+    Config::ConnectWithoutContext("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/State/RxError",
+                                  MakeCallback(&ChannelLoadMonitor::RxError, this));
+
+    std::ostringstream sink;
+    sink << "/NodeList/" << m_sink->GetId();
+    Config::ConnectWithoutContext(sink.str() + "/DeviceList/*/$ns3::WifiNetDevice/Phy/State/State",
+                                  MakeCallback(&ChannelLoadMonitor::SinkState, this));
+    Config::ConnectWithoutContext(sink.str() + "/$ns3::Ipv4L3Protocol/Rx",
+                                  MakeCallback(&ChannelLoadMonitor::SinkRx, this));
+    Config::ConnectWithoutContext(sink.str() + "/$ns3::Ipv4L3Protocol/Tx",
+                                  MakeCallback(&ChannelLoadMonitor::SinkTx, this));
+}
+
+inline void
+ChannelLoadMonitor::State(Time, Time duration, WifiPhyState state)
+{
+    if (state != WifiPhyState::TX)
+        return;
+    m_txAirtime += duration;
+    ++m_txFrames;
+}
+
+inline void
+ChannelLoadMonitor::RxError(Ptr<const Packet>, double)
+{
+    ++m_rxErrors;
+}
+
+inline void
+ChannelLoadMonitor::SinkState(Time, Time duration, WifiPhyState state)
+{
+    if (state == WifiPhyState::RX)
+        m_sinkRxAirtime += duration;
+}
+
+inline void
+ChannelLoadMonitor::SinkRx(Ptr<const Packet> packet, Ptr<Ipv4>, uint32_t interface)
+{
+    // Interface 0 is the loopback
+    if (interface == 0)
+        return;
+    ++m_sinkRxPackets;
+    m_sinkRxBytes += packet->GetSize();
+}
+
+inline void
+ChannelLoadMonitor::SinkTx(Ptr<const Packet>, Ptr<Ipv4>, uint32_t interface)
+{
+    if (interface != 0)
+        ++m_sinkTxPackets;
+}
+
+inline void
+ChannelLoadMonitor::PrintSummary(Time duration) const
+{
+    double seconds = duration.GetSeconds();
+
+    std::cout << "\n===== CHANNEL LOAD =====\n";
+    std::cout << "Frames transmitted: " << m_txFrames << "\n";
+    std::cout << "Tx airtime (all nodes): " << m_txAirtime.GetSeconds() << " s ("
+              << (seconds > 0 ? m_txAirtime.GetSeconds() / seconds : 0.0) << " s/s)\n";
+    std::cout << "Failed receptions (collisions/SNR): " << m_rxErrors << "\n";
+    std::cout << "Leader IP packets received: " << m_sinkRxPackets << " ("
+              << (seconds > 0 ? m_sinkRxPackets / seconds : 0.0) << " /s, "
+              << m_sinkRxBytes << " bytes)\n";
+    std::cout << "Leader IP packets sent: " << m_sinkTxPackets << "\n";
+    std::cout << "Leader Rx airtime: " << m_sinkRxAirtime.GetSeconds() << " s ("
+              << (seconds > 0 ? 100.0 * m_sinkRxAirtime.GetSeconds() / seconds : 0.0)
+              << " %)\n";
+    std::cout << "========================\n";
+}
+
+} // namespace ns3
+
+#endif /* CHANNEL_LOAD_MONITOR_H */
@@ -0,0 +1,351 @@
+#ifndef CLUSTER_AGGREGATION_H
+#define CLUSTER_AGGREGATION_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace ns3
+{
+
+/*
+ Cluster-head heartbeat aggregation
+ - Followers are split into units; each unit's head collects its
+   members' heartbeats (UdpClient, SeqTs stamped) and forwards one
+   aggregate per interval to the leader, carrying its own heartbeat too
+ - Aggregate wire format (big endian):
+     count u16, reserved u16, aggregate seq u32,
+     then count x (member IPv4 u32, send time ns i64)
+   An aggregate that would exceed one MTU is split
+ - The leader's AggregateSink unpacks the entries, so heartbeat delivery
+   and age are measured end to end, member to leader
+*/
+
+// ----- Unit assignment -----
+struct ClusterPlan
+{
+    std::vector<uint32_t> heads;   // follower indices
+    std::vector<uint32_t> headOf;  // per follower: index of its head (heads map to themselves)
+};
+
+// Heads are spread out by farthest-point selection over the formation
+// offsets; every other follower joins the nearest head
+inline ClusterPlan
+AssignClusters(const std::vector<Vector> &offsets, uint32_t clusterSize)
+{
+    NS_ABORT_MSG_IF(clusterSize == 0, "clusterSize must be at least 1");
+
+    ClusterPlan plan;
+    uint32_t n = offsets.size();
+    plan.headOf.assign(n, 0);
+    if (n == 0)
+        return plan;
+
+    uint32_t nHeads = (n + clusterSize - 1) / clusterSize;
+
+    // Distance from each follower to its nearest head so far
+    std::vector<double> nearest(n, std::numeric_limits<double>::max());
+    uint32_t next = 0;
+    for (uint32_t k = 0; k < nHeads; ++k)
+    {
+        uint32_t head = next;
+        plan.heads.push_back(head);
+
+        double farthest = -1.0;
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            double d = CalculateDistance(offsets[i], offsets[head]);
+            if (d < nearest[i])
+            {
+                nearest[i] = d;
+                plan.headOf[i] = head;
+            }
+            if (nearest[i] > farthest)
+            {
+                farthest = nearest[i];
+                next = i;
+            }
+        }
+    }
+    return plan;
+}
+
+// ----- Cluster head -----
+class ClusterHeadAggregator : public Application
+{
+  public:
+    static TypeId GetTypeId();
+
+    uint64_t GetHeartbeatsReceived() const { return m_received; }
+    uint64_t GetOwnHeartbeats() const { return m_own; }
+    uint64_t GetAggregatesSent() const { return m_sent; }
+
+    // count, reserved, seq + per entry address and timestamp
+    static const uint32_t HEADER_SIZE = 8;
+    static const uint32_t ENTRY_SIZE = 12;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    void StartApplication() override;
+    void StopApplication() override;
+
+    void Receive(Ptr<Socket> socket);
+    void Flush();
+
+    struct Entry
+    {
+        uint32_t address;
+        int64_t sentNs;
+    };
+
+    uint16_t m_port = 10;
+    Address m_remote;
+    Time m_interval;
+    uint32_t m_maxEntries = 120;
+
+    Ptr<Socket> m_rxSocket;
+    Ptr<Socket> m_txSocket;
+    EventId m_flushEvent;
+
+    std::vector<Entry> m_entries;
+    std::vector<uint8_t> m_wire;
+
+    uint32_t m_seq = 0;
+    uint64_t m_received = 0;
+    uint64_t m_own = 0;
+    uint64_t m_sent = 0;
+};
+
+NS_OBJECT_ENSURE_REGISTERED(ClusterHeadAggregator);
+
+inline TypeId
+ClusterHeadAggregator::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::ClusterHeadAggregator")
+            .SetParent<Application>()
+            .SetGroupName("Applications")
+            .AddConstructor<ClusterHeadAggregator>()
+            .AddAttribute("Port",
+                          "Port the members' heartbeats arrive on",
+                          UintegerValue(10),
+                          MakeUintegerAccessor(&ClusterHeadAggregator::m_port),
+                          MakeUintegerChecker<uint16_t>())
+            .AddAttribute("Remote",
+                          "Address and port of the leader's AggregateSink",
+                          AddressValue(),
+                          MakeAddressAccessor(&ClusterHeadAggregator::m_remote),
+                          MakeAddressChecker())
+            .AddAttribute("Interval",
+                          "Time between aggregates",
+                          TimeValue(Seconds(2.0)),
+                          MakeTimeAccessor(&ClusterHeadAggregator::m_interval),
+                          MakeTimeChecker())
+            .AddAttribute("MaxEntries",
+                          "Entries per aggregate packet before it is split (fits one MTU)",
+                          UintegerValue(120),
+                          MakeUintegerAccessor(&ClusterHeadAggregator::m_maxEntries),
+                          MakeUintegerChecker<uint32_t>(1, 120));
+    return tid;
+}
+
+inline void
+ClusterHeadAggregator::DoDispose()
+{
+    m_rxSocket = nullptr;
+    m_txSocket = nullptr;
+    Application::DoDispose();
+}
+
+inline void
+ClusterHeadAggregator::StartApplication()
+{
+    m_rxSocket = Socket::CreateSocket(GetNode(), UdpSocketFactory::GetTypeId());
+    m_rxSocket->Bind(InetSocketAddress(Ipv4Address::GetAny(), m_port));
+    m_rxSocket->SetRecvCallback(MakeCallback(&ClusterHeadAggregator::Receive, this));
+
+    m_txSocket = Socket::CreateSocket(GetNode(), UdpSocketFactory::GetTypeId());
+    m_txSocket->Bind();
+    m_txSocket->Connect(m_remote);
+
+    m_entries.reserve(m_maxEntries);
+    m_wire.resize(HEADER_SIZE + m_maxEntries * ENTRY_SIZE);
+    m_flushEvent = Simulator::Schedule(m_interval, &ClusterHeadAggregator::Flush, this);
+}
+
+inline void
+ClusterHeadAggregator::StopApplication()
+{
+    m_flushEvent.Cancel();
+    if (m_rxSocket)
+    {
+        m_rxSocket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+        m_rxSocket->Close();
+    }
+    if (m_txSocket)
+        m_txSocket->Close();
+}
+
+inline void
+ClusterHeadAggregator::Receive(Ptr<Socket> socket)
+{
+    Address from;
+    Ptr<Packet> packet;
+    while ((packet = socket->RecvFrom(from)))
+    {
+        SeqTsHeader header;
+        if (packet->GetSize() < header.GetSerializedSize())
+            continue;
+        packet->RemoveHeader(header);
+
+        ++m_received;
+        m_entries.push_back({InetSocketAddress::ConvertFrom(from).GetIpv4().Get(),
+                             header.GetTs().GetNanoSeconds()});
+    }
+}
+
+inline void
+ClusterHeadAggregator::Flush()
+{
+    // The head's own heartbeat rides in its aggregate
+    Ipv4Address self = GetNode()->GetObject<Ipv4>()->GetAddress(1, 0).GetLocal();
+    m_entries.push_back({self.Get(), Simulator::Now().GetNanoSeconds()});
+    ++m_own;
+
+    for (std::size_t first = 0; first < m_entries.size(); first += m_maxEntries)
+    {
+        uint32_t count = std::min<std::size_t>(m_maxEntries, m_entries.size() - first);
+
+        uint8_t *p = m_wire.data();
+        auto put = [&p](uint64_t value, uint32_t bytes) {
+            for (uint32_t b = bytes; b-- > 0;)
+                *p++ = static_cast<uint8_t>(value >> (8 * b));
+        };
+        put(count, 2);
+        put(0, 2);
+        put(m_seq++, 4);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            put(m_entries[first + i].address, 4);
+            put(static_cast<uint64_t>(m_entries[first + i].sentNs), 8);
+        }
+
+        m_txSocket->Send(Create<Packet>(m_wire.data(), p - m_wire.data()));
+        ++m_sent;
+    }
+
+    m_entries.clear();
+    m_flushEvent = Simulator::Schedule(m_interval, &ClusterHeadAggregator::Flush, this);
+}
+
+// ----- Leader side -----
+class AggregateSink : public Application
+{
+  public:
+    static TypeId GetTypeId();
+
+    uint64_t GetHeartbeats() const { return m_heartbeats; }
+    uint64_t GetAggregates() const { return m_aggregates; }
+    double GetMeanAge() const { return m_heartbeats ? m_ageSum / m_heartbeats : 0.0; }
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    void StartApplication() override;
+    void StopApplication() override;
+    void Receive(Ptr<Socket> socket);
+
+    uint16_t m_port = 9;
+    Ptr<Socket> m_socket;
+
+    uint64_t m_aggregates = 0;
+    uint64_t m_heartbeats = 0;
+    double m_ageSum = 0.0;
+};
+
+NS_OBJECT_ENSURE_REGISTERED(AggregateSink);
+
+inline TypeId
+AggregateSink::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::AggregateSink")
+            .SetParent<Application>()
+            .SetGroupName("Applications")
+            .AddConstructor<AggregateSink>()
+            .AddAttribute("Port",
+                          "Port aggregates arrive on",
+                          UintegerValue(9),
+                          MakeUintegerAccessor(&AggregateSink::m_port),
+                          MakeUintegerChecker<uint16_t>());
+    return tid;
+}
+
+inline void
+AggregateSink::DoDispose()
+{
+    m_socket = nullptr;
+    Application::DoDispose();
+}
+
+inline void
+AggregateSink::StartApplication()
+{
+    m_socket = Socket::CreateSocket(GetNode(), UdpSocketFactory::GetTypeId());
+    m_socket->Bind(InetSocketAddress(Ipv4Address::GetAny(), m_port));
+    m_socket->SetRecvCallback(MakeCallback(&AggregateSink::Receive, this));
+}
+
+inline void
+AggregateSink::StopApplication()
+{
+    if (m_socket)
+    {
+        m_socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+        m_socket->Close();
+    }
+}
+
+inline void
+AggregateSink::Receive(Ptr<Socket> socket)
+{
+    const uint32_t headerSize = ClusterHeadAggregator::HEADER_SIZE;
+    const uint32_t entrySize = ClusterHeadAggregator::ENTRY_SIZE;
+
+    uint8_t buf[1500];
+    int64_t now = Simulator::Now().GetNanoSeconds();
+
+    Ptr<Packet> packet;
+    while ((packet = socket->Recv()))
+    {
+        uint32_t len = packet->CopyData(buf, sizeof(buf));
+        if (len < headerSize)
+            continue;
+
+        uint32_t count = (uint32_t(buf[0]) << 8) | buf[1];
+        count = std::min(count, (len - headerSize) / entrySize);
+
+        ++m_aggregates;
+        m_heartbeats += count;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const uint8_t *e = buf + headerSize + i * entrySize + 4;
+            uint64_t sent = 0;
+            for (uint32_t b = 0; b < 8; ++b)
+                sent = (sent << 8) | e[b];
+            m_ageSum += (now - static_cast<int64_t>(sent)) * 1e-9;
+        }
+    }
+}
+
+} // namespace ns3
+
+#endif /* CLUSTER_AGGREGATION_H */
@@ -0,0 +1,284 @@
+#ifndef ENERGY_ACCOUNTING_H
+#define ENERGY_ACCOUNTING_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/energy-module.h"
+#if __has_include("ns3/version-defines.h")
+#include "ns3/version-defines.h"
+#endif
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace ns3
+{
+
+/*
+ Radio energy accounting
+ - Every node gets a BasicEnergySource (the radio's share of the
+   battery) and a WifiRadioEnergyModel on its Wi-Fi device. A node whose
+   source falls to the low-battery mark counts as depleted and has its
+   PHY switched off by the radio model
+ - Nothing is traced per state change: one event every SampleInterval
+   appends all sources' remaining energy to one flat table, which is
+   written as the depletion CSV (one column per node) at Finish().
+   The source's own periodic update is left idle, since the samples and
+   the radio's state changes already bring it up to date
+ - Delivered payload bits are counted like WindowedMetrics counts
+   packets (UDP from/to Port at LocalDeliver), giving joules per
+   delivered bit overall and per named segment (formation phase,
+   before/after the attack)
+*/
+class EnergyAccounting
+{
+  public:
+    struct Params
+    {
+        double initialEnergy = 100.0;          // J per node
+        double voltage = 3.0;                  // V
+        double lowBattery = 0.1;               // fraction left at which the radio stops
+        Time sampleInterval = Seconds(1.0);
+        uint16_t port = 9;
+    };
+
+    explicit EnergyAccounting(const Params &params) : m_params(params) {}
+
+    // Sources on the nodes, radio models on their Wi-Fi devices
+    void Install(const NodeContainer &nodes, const NetDeviceContainer &devices);
+
+    // Energy and delivered bits between start and end, in the summary
+    void AddSegment(const std::string &name, Time start, Time end);
+
+    // Optional depletion CSV: time and remaining energy per node
+    void SetOutput(const std::string &path) { m_path = path; }
+
+    // Final sample and CSV; call after Simulator::Run()
+    void Finish();
+
+    void PrintSummary() const;
+
+    double GetConsumed() const { return m_consumed; }
+    double GetJoulesPerBit() const { return m_bits > 0 ? m_consumed / m_bits : 0.0; }
+
+  private:
+    struct Segment
+    {
+        std::string name;
+        Time start;
+        Time end;
+        double energyStart = 0.0;
+        double energyEnd = 0.0;
+        uint64_t bitsStart = 0;
+        uint64_t bitsEnd = 0;
+    };
+
+    void Sample();
+    void Capture(uint32_t segment, bool end);
+    double TotalConsumed() const;
+    void Delivered(const Ipv4Header &header, Ptr<const Packet> packet, uint32_t interface);
+
+    // ns-3.41 moved the energy model classes into ns3::energy. Without
+    // build version defines, a current release is assumed
+#if !defined(NS3_VERSION_MAJOR) || NS3_VERSION_MAJOR > 3 || NS3_VERSION_MINOR >= 41
+    using EnergySource = energy::EnergySource;
+#endif
+
+    Params m_params;
+    std::vector<Ptr<EnergySource>> m_sources;
+
+    std::vector<double> m_times;
+    std::vector<double> m_remaining;   // row-major, one row per sample
+    std::vector<double> m_depleted;    // per node, first sample at the low-battery mark, -1 = never
+    EventId m_event;
+
+    std::vector<Segment> m_segments;
+    std::string m_path;
+
+    uint64_t m_bits = 0;
+    double m_consumed = 0.0;
+};
+
+inline void
+EnergyAccounting::Install(const NodeContainer &nodes, const NetDeviceContainer &devices)
+{
+    BasicEnergySourceHelper source;
+    source.Set("BasicEnergySourceInitialEnergyJ", DoubleValue(m_params.initialEnergy));
+    source.Set("BasicEnergySupplyVoltageV", DoubleValue(m_params.voltage));
+    source.Set("BasicEnergyLowBatteryThreshold", DoubleValue(m_params.lowBattery));
+    source.Set("PeriodicEnergyUpdateInterval", TimeValue(Hours(1)));
+
+    auto sources = source.Install(nodes);   // EnergySourceContainer, namespace varies
+    WifiRadioEnergyModelHelper radio;
+    radio.Install(devices, sources);
+
+    for (uint32_t i = 0; i < sources.GetN(); ++i)
+        m_sources.push_back(sources.Get(i));
+    m_depleted.assign(m_sources.size(), -1.0);
+
+    Config::ConnectWithoutContext("/NodeList/*/$ns3::Ipv4L3Protocol/LocalDeliver",
+                                  MakeCallback(&EnergyAccounting::Delivered, this));
+
+    m_event = Simulator::ScheduleNow(&EnergyAccounting::Sample, this);
+}
+
+inline void
+EnergyAccounting::AddSegment(const std::string &name, Time start, Time end)
+{
+    m_segments.push_back({name, start, end});
+    uint32_t index = m_segments.size() - 1;
+    Simulator::Schedule(start, &EnergyAccounting::Capture, this, index, false);
+    Simulator::Schedule(end, &EnergyAccounting::Capture, this, index, true);
+}
+
+inline void
+EnergyAccounting::Delivered(const Ipv4Header &header, Ptr<const Packet> packet, uint32_t)
+{
+    if (header.GetProtocol() != UdpL4Protocol::PROT_NUMBER)
+        return;
+
+    UdpHeader udp;
+    packet->PeekHeader(udp);
+    if (udp.GetDestinationPort() == m_params.port || udp.GetSourcePort() == m_params.port)
+        m_bits += (packet->GetSize() - udp.GetSerializedSize()) * 8;
+}
+
+inline double
+EnergyAccounting::TotalConsumed() const
+{
+    double consumed = 0.0;
+    for (const auto &source : m_sources)
+        consumed += m_params.initialEnergy - source->GetRemainingEnergy();
+    return consumed;
+}
+
+inline void
+EnergyAccounting::Sample()
+{
+    double now = Simulator::Now().GetSeconds();
+    double empty = m_params.lowBattery * m_params.initialEnergy;
+    m_times.push_back(now);
+    for (uint32_t i = 0; i < m_sources.size(); ++i)
+    {
+        double remaining = m_sources[i]->GetRemainingEnergy();
+        m_remaining.push_back(remaining);
+        if (remaining <= empty && m_depleted[i] < 0)
+            m_depleted[i] = now;
+    }
+
+    m_event = Simulator::Schedule(m_params.sampleInterval, &EnergyAccounting::Sample, this);
+}
+
+inline void
+EnergyAccounting::Capture(uint32_t segment, bool end)
+{
+    Segment &s = m_segments[segment];
+    (end ? s.energyEnd : s.energyStart) = TotalConsumed();
+    (end ? s.bitsEnd : s.bitsStart) = m_bits;
+}
+
+inline void
+EnergyAccounting::Finish()
+{
+    m_event.Cancel();
+    if (m_times.empty() || m_times.back() < Simulator::Now().GetSeconds())
+        Sample();
+    m_event.Cancel();
+
+    m_consumed = TotalConsumed();
+
+    // Segments that reach the end of the simulation close now
+    for (Segment &s : m_segments)
+    {
+        if (s.end >= Simulator::Now())
+        {
+            s.energyEnd = m_consumed;
+            s.bitsEnd = m_bits;
+        }
+    }
+
+    if (m_path.empty())
+        return;
+
+    std::ofstream out(m_path);
+    NS_ABORT_MSG_IF(!out, "Cannot open " << m_path);
+    out << "time";
+    for (uint32_t i = 0; i < m_sources.size(); ++i)
+        out << ",node" << i;
+    out << "\n";
+    for (uint32_t row = 0; row < m_times.size(); ++row)
+    {
+        out << m_times[row];
+        for (uint32_t i = 0; i < m_sources.size(); ++i)
+            out << ',' << m_remaining[row * m_sources.size() + i];
+        out << "\n";
+    }
+}
+
+inline void
+EnergyAccounting::PrintSummary() const
+{
+    uint32_t n = m_sources.size();
+    uint32_t hungriest = 0;
+    double most = 0.0;
+    uint32_t depleted = 0;
+    int32_t firstNode = -1;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        double used = m_params.initialEnergy - m_sources[i]->GetRemainingEnergy();
+        if (used > most)
+        {
+            most = used;
+            hungriest = i;
+        }
+        if (m_depleted[i] >= 0)
+        {
+            ++depleted;
+            if (firstNode < 0 || m_depleted[i] < m_depleted[firstNode])
+                firstNode = i;
+        }
+    }
+
+    std::cout << "\n===== ENERGY =====\n";
+    std::cout << "Radio budget: " << m_params.initialEnergy << " J per node\n";
+    std::cout << "Consumed: " << m_consumed << " J (mean " << (n ? m_consumed / n : 0.0)
+              << " J/node, max " << most << " J on node " << hungriest << ")\n";
+    std::cout << "Delivered payload: " << m_bits / 1000.0 << " kbit\n";
+    std::cout << "Energy per delivered bit: " << GetJoulesPerBit() * 1e6 << " uJ/bit\n";
+    std::cout << "Depleted nodes: " << depleted;
+    if (firstNode >= 0)
+        std::cout << " (first: node " << firstNode << " at " << m_depleted[firstNode] << " s)";
+    std::cout << "\n";
+
+    if (!m_segments.empty())
+    {
+        std::cout << std::left << std::setw(16) << "Segment"
+                  << std::right << std::setw(14) << "Time (s)"
+                  << std::setw(12) << "Energy (J)"
+                  << std::setw(14) << "Rcvd (kbit)"
+                  << std::setw(12) << "uJ/bit" << "\n";
+        for (const Segment &s : m_segments)
+        {
+            std::ostringstream span;
+            span << s.start.GetSeconds() << "-" << s.end.GetSeconds();
+            double energy = s.energyEnd - s.energyStart;
+            uint64_t bits = s.bitsEnd - s.bitsStart;
+
+            std::cout << std::left << std::setw(16) << s.name
+                      << std::right << std::setw(14) << span.str()
+                      << std::setw(12) << energy
+                      << std::setw(14) << bits / 1000.0
+                      << std::setw(12) << (bits ? energy / bits * 1e6 : 0.0) << "\n";
+        }
+    }
+    std::cout << "==================\n";
+}
+
+} // namespace ns3
+
+#endif /* ENERGY_ACCOUNTING_H */
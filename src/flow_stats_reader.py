@@ -0,0 +1,99 @@
+"""
+Incremental reader for the per-flow CSV streams written by
+FlowStatsStreamWriter (flow_stats_stream.h).
+
+Each row holds one flow's counters for one sampling interval, so totals
+are plain sums and the file can be consumed row by row while the run is
+still writing it (follow=True), with memory bounded by the flow count.
+"""
+
+import csv
+import time
+
+INT_FIELDS = ("flow", "srcPort", "dstPort", "protocol", "txPackets",
+              "rxPackets", "txBytes", "rxBytes", "lostPackets")
+FLOAT_FIELDS = ("time", "delaySum", "jitterSum",
+                "timeFirstTxPacket", "timeLastRxPacket")
+
+
+def _lines(f, follow, poll):
+    """
+    Yield data lines. With follow, waits for new lines until the
+    writer's "# end" marker appears.
+    """
+    while True:
+        line = f.readline()
+        if not line:
+            if not follow:
+                return
+            time.sleep(poll)
+            continue
+        if line.startswith("#"):
+            if line.strip() == "# end":
+                return
+            continue
+        yield line
+
+
+def iter_records(path, follow=False, poll=0.5):
+    """
+    Yield one dict per CSV row with numeric fields converted.
+    """
+    with open(path, newline="") as f:
+        reader = csv.DictReader(_lines(f, follow, poll))
+        for row in reader:
+            for key in INT_FIELDS:
+                row[key] = int(row[key])
+            for key in FLOAT_FIELDS:
+                row[key] = float(row[key])
+            yield row
+
+
+def accumulate(records):
+    """
+    Fold interval records into per-flow totals.
+    """
+    flows = {}
+    for r in records:
+        f = flows.get(r["flow"])
+        if f is None:
+            f = flows[r["flow"]] = {
+                "src": r["src"], "dst": r["dst"],
+                "txPackets": 0, "rxPackets": 0, "txBytes": 0, "rxBytes": 0,
+                "lostPackets": 0, "delaySum": 0.0, "jitterSum": 0.0,
+                "timeFirstTxPacket": r["timeFirstTxPacket"],
+                "timeLastRxPacket": 0.0,
+            }
+        for key in ("txPackets", "rxPackets", "txBytes", "rxBytes",
+                    "lostPackets", "delaySum", "jitterSum"):
+            f[key] += r[key]
+        f["timeLastRxPacket"] = r["timeLastRxPacket"]
+    return flows
+
+
+def flow_metrics(flows):
+    """
+    PDR (%), average delay (s) and aggregate throughput (kbps), computed
+    the same way as the metrics block in the C++ scenarios.
+    """
+    tx = rx = delay = throughput = 0.0
+
+    for f in flows.values():
+        tx += f["txPackets"]
+        rx += f["rxPackets"]
+        delay += f["delaySum"]
+
+        duration = f["timeLastRxPacket"] - f["timeFirstTxPacket"]
+        if f["timeLastRxPacket"] > 0 and duration > 0:
+            throughput += f["rxBytes"] * 8.0 / duration
+
+    pdr = (rx / tx) * 100 if tx > 0 else 0
+    avg_delay = delay / rx if rx > 0 else 0
+    return pdr, avg_delay, throughput / 1000
+
+
+def extract_metrics(path, follow=False):
+    """
+    Stream a file and return (pdr, avg_delay, throughput_kbps).
+    """
+    return flow_metrics(accumulate(iter_records(path, follow)))
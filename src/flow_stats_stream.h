@@ -0,0 +1,163 @@
+#ifndef FLOW_STATS_STREAM_H
+#define FLOW_STATS_STREAM_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/flow-monitor-module.h"
+
+#include <fstream>
+#include <unordered_map>
+
+namespace ns3
+{
+
+/*
+ Streaming FlowMonitor sink
+ - Every Interval, appends one CSV row per flow that changed since the
+   previous sample. Counters are deltas for that interval, so a reader
+   can sum rows as they arrive
+ - Memory is one cumulative snapshot per flow; nothing is buffered
+   beyond the current sample, and rows are flushed as they are written
+ - Finish() writes the final sample (after CheckForLostPackets) and an
+   "# end" marker so a reader following the file knows the run is over
+ - flow_stats_reader.py reads the format incrementally
+*/
+class FlowStatsStreamWriter
+{
+  public:
+    FlowStatsStreamWriter(Ptr<FlowMonitor> monitor,
+                          Ptr<Ipv4FlowClassifier> classifier,
+                          const std::string &path,
+                          Time interval = Seconds(1.0));
+
+    // Schedule periodic sampling; call before Simulator::Run()
+    void Start();
+
+    // Final sample and end marker; call after CheckForLostPackets()
+    void Finish();
+
+    // Forked sweeps: write out anything buffered before fork(), then, in
+    // the child, carry on in a copy of the file written so far
+    void Flush() { m_out.flush(); }
+    void ContinueAs(const std::string &path);
+
+  private:
+    struct Snapshot
+    {
+        uint32_t txPackets = 0;
+        uint32_t rxPackets = 0;
+        uint64_t txBytes = 0;
+        uint64_t rxBytes = 0;
+        uint32_t lostPackets = 0;
+        Time delaySum;
+        Time jitterSum;
+    };
+
+    void Sample();
+
+    Ptr<FlowMonitor> m_monitor;
+    Ptr<Ipv4FlowClassifier> m_classifier;
+    std::ofstream m_out;
+    std::string m_path;
+    Time m_interval;
+    EventId m_event;
+    std::unordered_map<FlowId, Snapshot> m_last;
+};
+
+inline
+FlowStatsStreamWriter::FlowStatsStreamWriter(Ptr<FlowMonitor> monitor,
+                                             Ptr<Ipv4FlowClassifier> classifier,
+                                             const std::string &path,
+                                             Time interval)
+    : m_monitor(monitor),
+      m_classifier(classifier),
+      m_out(path),
+      m_path(path),
+      m_interval(interval)
+{
+    NS_ABORT_MSG_IF(!m_out, "Cannot open " << path);
+
+    m_out << "# interval=" << m_interval.GetSeconds() << "\n";
+    m_out << "time,flow,src,dst,srcPort,dstPort,protocol,"
+             "txPackets,rxPackets,txBytes,rxBytes,lostPackets,delaySum,jitterSum,"
+             "timeFirstTxPacket,timeLastRxPacket\n";
+}
+
+inline void
+FlowStatsStreamWriter::Start()
+{
+    m_event = Simulator::Schedule(m_interval, &FlowStatsStreamWriter::Sample, this);
+}
+
+inline void
+FlowStatsStreamWriter::Sample()
+{
+    double now = Simulator::Now().GetSeconds();
+
+    for (const auto &flow : m_monitor->GetFlowStats())
+    {
+        const FlowMonitor::FlowStats &st = flow.second;
+        Snapshot &last = m_last[flow.first];
+
+        if (st.txPackets == last.txPackets && st.rxPackets == last.rxPackets &&
+            st.lostPackets == last.lostPackets)
+            continue;
+
+        Ipv4FlowClassifier::FiveTuple t = m_classifier->FindFlow(flow.first);
+
+        m_out << now << ',' << flow.first << ','
+              << t.sourceAddress << ',' << t.destinationAddress << ','
+              << t.sourcePort << ',' << t.destinationPort << ','
+              << static_cast<uint32_t>(t.protocol) << ','
+              << st.txPackets - last.txPackets << ','
+              << st.rxPackets - last.rxPackets << ','
+              << st.txBytes - last.txBytes << ','
+              << st.rxBytes - last.rxBytes << ','
+              << st.lostPackets - last.lostPackets << ','
+              << (st.delaySum - last.delaySum).GetSeconds() << ','
+              << (st.jitterSum - last.jitterSum).GetSeconds() << ','
+              << st.timeFirstTxPacket.GetSeconds() << ','
+              << st.timeLastRxPacket.GetSeconds() << '\n';
+
+        last.txPackets = st.txPackets;
+        last.rxPackets = st.rxPackets;
+        last.txBytes = st.txBytes;
+        last.rxBytes = st.rxBytes;
+        last.lostPackets = st.lostPackets;
+        last.delaySum = st.delaySum;
+        last.jitterSum = st.jitterSum;
+    }
+    m_out.flush();
+
+    m_event = Simulator::Schedule(m_interval, &FlowStatsStreamWriter::Sample, this);
+}
+
+inline void
+FlowStatsStreamWriter::Finish()
+{
+    m_event.Cancel();
+    Sample();
+    m_event.Cancel();
+
+    m_out << "# end\n";
+    m_out.close();
+}
+
+inline void
+FlowStatsStreamWriter::ContinueAs(const std::string &path)
+{
+    m_out.close();
+    {
+        std::ifstream in(m_path, std::ios::binary);
+        std::ofstream out(path, std::ios::binary);
+        NS_ABORT_MSG_IF(!out, "Cannot open " << path);
+        out << in.rdbuf();
+    }
+    m_out.open(path, std::ios::app);
+    m_path = path;
+}
+
+} // namespace ns3
+
+#endif /* FLOW_STATS_STREAM_H */
@@ -0,0 +1,212 @@
+#ifndef FORMATION_FOLLOWER_MOBILITY_MODEL_H
+#define FORMATION_FOLLOWER_MOBILITY_MODEL_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+
+#include "swarm_formation.h"
+
+#include <deque>
+
+namespace ns3
+{
+
+/*
+ Lazy formation followers
+ - LeaderTrack records the leader's piecewise constant-velocity path
+   from its CourseChange trace (one entry per velocity change)
+ - FormationFollowerMobilityModel evaluates
+       position(t) = leaderPosition(t - Lag) + formation offset
+   only when someone asks, so there is no periodic update event and
+   positions are continuous instead of snapping every 2 s
+*/
+
+// ----- Leader trajectory history -----
+class LeaderTrack : public SimpleRefCount<LeaderTrack>
+{
+  public:
+    explicit LeaderTrack(Ptr<MobilityModel> leader);
+
+    // Keep enough history to answer queries this far in the past
+    void SetHorizon(Time horizon) { m_horizon = Max(m_horizon, horizon); }
+
+    Vector GetPosition(Time t) const;
+    Vector GetVelocity(Time t) const;
+
+  private:
+    struct Segment
+    {
+        Time start;
+        Vector position;
+        Vector velocity;
+    };
+
+    void CourseChanged(Ptr<const MobilityModel> leader);
+    const Segment &Find(Time t) const;
+
+    std::deque<Segment> m_segments;
+    Time m_horizon;
+};
+
+inline
+LeaderTrack::LeaderTrack(Ptr<MobilityModel> leader)
+{
+    m_segments.push_back({Simulator::Now(), leader->GetPosition(), leader->GetVelocity()});
+    leader->TraceConnectWithoutContext("CourseChange",
+                                       MakeCallback(&LeaderTrack::CourseChanged, this));
+}
+
+inline void
+LeaderTrack::CourseChanged(Ptr<const MobilityModel> leader)
+{
+    Time now = Simulator::Now();
+    m_segments.push_back({now, leader->GetPosition(), leader->GetVelocity()});
+
+    // Drop segments that ended before the oldest time still queried
+    while (m_segments.size() > 1 && m_segments[1].start <= now - m_horizon)
+    {
+        m_segments.pop_front();
+    }
+}
+
+inline const LeaderTrack::Segment &
+LeaderTrack::Find(Time t) const
+{
+    // Queries are close to "now", so scan from the newest segment
+    for (auto it = m_segments.rbegin(); it != m_segments.rend(); ++it)
+    {
+        if (it->start <= t)
+            return *it;
+    }
+    return m_segments.front();
+}
+
+inline Vector
+LeaderTrack::GetPosition(Time t) const
+{
+    const Segment &s = Find(t);
+    if (t <= s.start)
+        return s.position;   // before the recorded history: hold
+
+    double dt = (t - s.start).GetSeconds();
+    return Vector(s.position.x + s.velocity.x * dt,
+                  s.position.y + s.velocity.y * dt,
+                  s.position.z + s.velocity.z * dt);
+}
+
+inline Vector
+LeaderTrack::GetVelocity(Time t) const
+{
+    const Segment &s = Find(t);
+    return (t < s.start) ? Vector(0.0, 0.0, 0.0) : s.velocity;
+}
+
+// ----- Follower mobility model -----
+class FormationFollowerMobilityModel : public MobilityModel
+{
+  public:
+    static TypeId GetTypeId();
+
+    // Attach to follower slot `index` of a formation. The formation must
+    // outlive the simulation (it is a scenario-level object)
+    void Bind(SwarmFormation *formation, uint32_t index, Ptr<LeaderTrack> track);
+
+  private:
+    void FormationChanged() { NotifyCourseChange(); }
+
+    Vector DoGetPosition() const override;
+    void DoSetPosition(const Vector &position) override;
+    Vector DoGetVelocity() const override;
+
+    const SwarmFormation *m_formation = nullptr;
+    uint32_t m_index = 0;
+    Ptr<LeaderTrack> m_track;
+    Time m_lag;
+    Vector m_position;   // used until bound
+};
+
+NS_OBJECT_ENSURE_REGISTERED(FormationFollowerMobilityModel);
+
+inline TypeId
+FormationFollowerMobilityModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::FormationFollowerMobilityModel")
+            .SetParent<MobilityModel>()
+            .SetGroupName("Mobility")
+            .AddConstructor<FormationFollowerMobilityModel>()
+            .AddAttribute("Lag",
+                          "How far behind the leader's path the follower flies",
+                          TimeValue(Seconds(2.0)),
+                          MakeTimeAccessor(&FormationFollowerMobilityModel::m_lag),
+                          MakeTimeChecker(Seconds(0.0)));
+    return tid;
+}
+
+inline void
+FormationFollowerMobilityModel::Bind(SwarmFormation *formation,
+                                     uint32_t index,
+                                     Ptr<LeaderTrack> track)
+{
+    m_formation = formation;
+    m_index = index;
+    m_track = track;
+    m_track->SetHorizon(m_lag);
+
+    // Formation switches move the follower instantly
+    formation->AddChangeListener(
+        MakeCallback(&FormationFollowerMobilityModel::FormationChanged, this));
+}
+
+inline Vector
+FormationFollowerMobilityModel::DoGetPosition() const
+{
+    if (!m_track)
+        return m_position;
+
+    Vector leaderPos = m_track->GetPosition(Simulator::Now() - m_lag);
+    Vector offset = m_formation->GetOffset(m_index);
+    return Vector(leaderPos.x + offset.x, leaderPos.y + offset.y, leaderPos.z + offset.z);
+}
+
+inline void
+FormationFollowerMobilityModel::DoSetPosition(const Vector &position)
+{
+    // Only meaningful before Bind(); afterwards the formation decides
+    m_position = position;
+    NotifyCourseChange();
+}
+
+inline Vector
+FormationFollowerMobilityModel::DoGetVelocity() const
+{
+    if (!m_track)
+        return Vector(0.0, 0.0, 0.0);
+
+    // Leader's velocity plus the drift of a running formation transition
+    Vector leaderVel = m_track->GetVelocity(Simulator::Now() - m_lag);
+    Vector drift = m_formation->GetOffsetVelocity(m_index);
+    return Vector(leaderVel.x + drift.x, leaderVel.y + drift.y, leaderVel.z + drift.z);
+}
+
+// ----- Bind every follower of a formation -----
+inline void
+BindFormationFollowers(SwarmFormation &formation,
+                       Ptr<Node> leader,
+                       const NodeContainer &followers)
+{
+    Ptr<LeaderTrack> track = Create<LeaderTrack>(leader->GetObject<MobilityModel>());
+
+    for (uint32_t i = 0; i < followers.GetN(); ++i)
+    {
+        Ptr<FormationFollowerMobilityModel> mob =
+            followers.Get(i)->GetObject<FormationFollowerMobilityModel>();
+        NS_ABORT_MSG_IF(!mob, "Follower " << i << " is not a FormationFollowerMobilityModel");
+        mob->Bind(&formation, i, track);
+    }
+}
+
+} // namespace ns3
+
+#endif /* FORMATION_FOLLOWER_MOBILITY_MODEL_H */
@@ -0,0 +1,183 @@
+#ifndef FORWARDING_ATTACK_H
+#define FORWARDING_ATTACK_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+
+namespace ns3
+{
+
+/*
+ Forwarding-path attack filter
+ - An Ipv4RoutingProtocol added to the node's Ipv4ListRouting above the
+   real routing protocol. Ipv4ListRouting delivers local packets (and
+   broadcast control traffic such as AODV RREQs) before asking any
+   protocol, so RouteInput here only ever sees packets in transit
+ - While Active, a transit packet is dropped with DropProbability
+   (1.0 = blackhole); otherwise RouteInput returns false and the packet
+   falls through to the real protocol untouched
+ - Packets the node originates are never dropped: RouteOutput declines,
+   and packets AODV defers through the loopback device are let through
+ - Per-packet cost is one pointer compare, one RNG draw and two counters
+   (no allocation)
+*/
+class ForwardingAttackFilter : public Ipv4RoutingProtocol
+{
+  public:
+    static TypeId GetTypeId();
+
+    ForwardingAttackFilter() : m_rand(CreateObject<UniformRandomVariable>()) {}
+
+    void SetActive(bool active) { m_active = active; }
+    bool IsActive() const { return m_active; }
+    void SetDropProbability(double p) { m_dropProbability = p; }
+
+    uint64_t GetTransitPackets() const { return m_transit; }
+    uint64_t GetDroppedPackets() const { return m_dropped; }
+
+    Ptr<Ipv4Route> RouteOutput(Ptr<Packet> p,
+                               const Ipv4Header &header,
+                               Ptr<NetDevice> oif,
+                               Socket::SocketErrno &sockerr) override;
+
+    bool RouteInput(Ptr<const Packet> p,
+                    const Ipv4Header &header,
+                    Ptr<const NetDevice> idev,
+                    const UnicastForwardCallback &ucb,
+                    const MulticastForwardCallback &mcb,
+                    const LocalDeliverCallback &lcb,
+                    const ErrorCallback &ecb) override;
+
+    void NotifyInterfaceUp(uint32_t interface) override {}
+    void NotifyInterfaceDown(uint32_t interface) override {}
+    void NotifyAddAddress(uint32_t interface, Ipv4InterfaceAddress address) override {}
+    void NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress address) override {}
+    void SetIpv4(Ptr<Ipv4> ipv4) override { m_ipv4 = ipv4; }
+
+    void PrintRoutingTable(Ptr<OutputStreamWrapper> stream,
+                           Time::Unit unit = Time::S) const override;
+
+    int64_t AssignStreams(int64_t stream);
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    bool m_active = false;
+    double m_dropProbability = 1.0;
+    Ptr<UniformRandomVariable> m_rand;
+
+    Ptr<Ipv4> m_ipv4;
+    Ptr<NetDevice> m_loopback;
+
+    uint64_t m_transit = 0;
+    uint64_t m_dropped = 0;
+};
+
+NS_OBJECT_ENSURE_REGISTERED(ForwardingAttackFilter);
+
+inline TypeId
+ForwardingAttackFilter::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::ForwardingAttackFilter")
+            .SetParent<Ipv4RoutingProtocol>()
+            .SetGroupName("Internet")
+            .AddConstructor<ForwardingAttackFilter>()
+            .AddAttribute("Active",
+                          "Whether transit packets are being dropped",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ForwardingAttackFilter::m_active),
+                          MakeBooleanChecker())
+            .AddAttribute("DropProbability",
+                          "Probability of dropping a transit packet while active",
+                          DoubleValue(1.0),
+                          MakeDoubleAccessor(&ForwardingAttackFilter::m_dropProbability),
+                          MakeDoubleChecker<double>(0.0, 1.0));
+    return tid;
+}
+
+inline void
+ForwardingAttackFilter::DoDispose()
+{
+    m_ipv4 = nullptr;
+    m_loopback = nullptr;
+    m_rand = nullptr;
+    Ipv4RoutingProtocol::DoDispose();
+}
+
+inline int64_t
+ForwardingAttackFilter::AssignStreams(int64_t stream)
+{
+    m_rand->SetStream(stream);
+    return 1;
+}
+
+inline Ptr<Ipv4Route>
+ForwardingAttackFilter::RouteOutput(Ptr<Packet>, const Ipv4Header &, Ptr<NetDevice>,
+                                    Socket::SocketErrno &sockerr)
+{
+    // Never route the node's own packets; the next protocol does
+    sockerr = Socket::ERROR_NOROUTETOHOST;
+    return nullptr;
+}
+
+inline bool
+ForwardingAttackFilter::RouteInput(Ptr<const Packet> p,
+                                   const Ipv4Header &header,
+                                   Ptr<const NetDevice> idev,
+                                   const UnicastForwardCallback &,
+                                   const MulticastForwardCallback &,
+                                   const LocalDeliverCallback &,
+                                   const ErrorCallback &ecb)
+{
+    if (!m_active)
+        return false;
+
+    // Interface 0 is always the loopback; packets arriving on it were
+    // originated here and deferred by the routing protocol
+    if (!m_loopback)
+        m_loopback = m_ipv4->GetNetDevice(0);
+    if (idev == m_loopback)
+        return false;
+
+    ++m_transit;
+    if (m_dropProbability < 1.0 && m_rand->GetValue() >= m_dropProbability)
+        return false;   // forward normally
+
+    // Consumed: the packet is reported through Ipv4L3Protocol's Drop trace
+    ++m_dropped;
+    ecb(p, header, Socket::ERROR_NOROUTETOHOST);
+    return true;
+}
+
+inline void
+ForwardingAttackFilter::PrintRoutingTable(Ptr<OutputStreamWrapper> stream, Time::Unit) const
+{
+    *stream->GetStream() << "ForwardingAttackFilter: active=" << m_active
+                         << " p=" << m_dropProbability
+                         << " transit=" << m_transit
+                         << " dropped=" << m_dropped << "\n";
+}
+
+// Add an (inactive) filter to a node whose stack uses Ipv4ListRouting, the
+// InternetStackHelper default. Wrap other protocols in an Ipv4ListRoutingHelper
+inline Ptr<ForwardingAttackFilter>
+InstallForwardingAttackFilter(Ptr<Node> node, double dropProbability, int16_t priority = 100)
+{
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    NS_ABORT_MSG_IF(!ipv4, "Node " << node->GetId() << " has no IPv4 stack");
+
+    Ptr<Ipv4ListRouting> list = DynamicCast<Ipv4ListRouting>(ipv4->GetRoutingProtocol());
+    NS_ABORT_MSG_IF(!list, "Node " << node->GetId() << " does not use Ipv4ListRouting");
+
+    Ptr<ForwardingAttackFilter> filter = CreateObject<ForwardingAttackFilter>();
+    filter->SetDropProbability(dropProbability);
+    list->AddRoutingProtocol(filter, priority);
+    return filter;
+}
+
+} // namespace ns3
+
+#endif /* FORWARDING_ATTACK_H */
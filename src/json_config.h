@@ -0,0 +1,202 @@
+#ifndef JSON_CONFIG_H
+#define JSON_CONFIG_H
+
+#include "ns3/core-module.h"
+
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/*
+ Minimal JSON reader for scenario files
+ - Objects, arrays, strings, numbers, true/false/null. Scalars are kept
+   as their text so each field parses them with its own type
+ - Object keys keep file order (later keys override earlier ones when
+   applied to a config)
+ - Syntax errors abort with the byte offset
+*/
+struct JsonValue
+{
+    enum Type
+    {
+        NUL,
+        SCALAR,
+        OBJECT,
+        ARRAY
+    };
+
+    Type type = NUL;
+    std::string text;                                      // SCALAR
+    std::vector<std::pair<std::string, JsonValue>> members; // OBJECT
+    std::vector<JsonValue> items;                          // ARRAY
+
+    const JsonValue *Find(const std::string &key) const
+    {
+        for (const auto &m : members)
+        {
+            if (m.first == key)
+                return &m.second;
+        }
+        return nullptr;
+    }
+};
+
+class JsonReader
+{
+  public:
+    explicit JsonReader(const std::string &text) : m_text(text) {}
+
+    JsonValue Parse()
+    {
+        JsonValue v = Value();
+        SkipSpace();
+        NS_ABORT_MSG_IF(m_pos != m_text.size(), "JSON: trailing data at offset " << m_pos);
+        return v;
+    }
+
+    static JsonValue ParseFile(const std::string &path)
+    {
+        std::ifstream in(path);
+        NS_ABORT_MSG_IF(!in, "Cannot open " << path);
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        return JsonReader(buffer.str()).Parse();
+    }
+
+  private:
+    void SkipSpace()
+    {
+        while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos])))
+            ++m_pos;
+    }
+
+    char Peek()
+    {
+        SkipSpace();
+        NS_ABORT_MSG_IF(m_pos >= m_text.size(), "JSON: unexpected end of input");
+        return m_text[m_pos];
+    }
+
+    void Expect(char c)
+    {
+        NS_ABORT_MSG_IF(Peek() != c, "JSON: expected '" << c << "' at offset " << m_pos);
+        ++m_pos;
+    }
+
+    JsonValue Value()
+    {
+        char c = Peek();
+        if (c == '{')
+            return Object();
+        if (c == '[')
+            return Array();
+
+        JsonValue v;
+        if (c == '"')
+        {
+            v.type = JsonValue::SCALAR;
+            v.text = String();
+            return v;
+        }
+
+        // number, true, false, null
+        std::size_t start = m_pos;
+        while (m_pos < m_text.size() && std::string(",]} \t\r\n").find(m_text[m_pos]) == std::string::npos)
+            ++m_pos;
+        NS_ABORT_MSG_IF(m_pos == start, "JSON: unexpected '" << c << "' at offset " << start);
+
+        v.text = m_text.substr(start, m_pos - start);
+        v.type = (v.text == "null") ? JsonValue::NUL : JsonValue::SCALAR;
+        return v;
+    }
+
+    std::string String()
+    {
+        Expect('"');
+        std::string out;
+        while (true)
+        {
+            NS_ABORT_MSG_IF(m_pos >= m_text.size(), "JSON: unterminated string");
+            char c = m_text[m_pos++];
+            if (c == '"')
+                return out;
+            if (c == '\\')
+            {
+                NS_ABORT_MSG_IF(m_pos >= m_text.size(), "JSON: unterminated string");
+                char e = m_text[m_pos++];
+                switch (e)
+                {
+                case 'n': out += '\n'; break;
+                case 't': out += '\t'; break;
+                case 'r': out += '\r'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                default: out += e; break;   // \" \\ \/ (no \u escapes)
+                }
+                continue;
+            }
+            out += c;
+        }
+    }
+
+    JsonValue Object()
+    {
+        JsonValue v;
+        v.type = JsonValue::OBJECT;
+        Expect('{');
+        if (Peek() == '}')
+        {
+            ++m_pos;
+            return v;
+        }
+        while (true)
+        {
+            std::string key = String();
+            Expect(':');
+            v.members.emplace_back(key, Value());
+            if (Peek() == ',')
+            {
+                ++m_pos;
+                continue;
+            }
+            Expect('}');
+            return v;
+        }
+    }
+
+    JsonValue Array()
+    {
+        JsonValue v;
+        v.type = JsonValue::ARRAY;
+        Expect('[');
+        if (Peek() == ']')
+        {
+            ++m_pos;
+            return v;
+        }
+        while (true)
+        {
+            v.items.push_back(Value());
+            if (Peek() == ',')
+            {
+                ++m_pos;
+                continue;
+            }
+            Expect(']');
+            return v;
+        }
+    }
+
+    std::string m_text;
+    std::size_t m_pos = 0;
+};
+
+} // namespace ns3
+
+#endif /* JSON_CONFIG_H */
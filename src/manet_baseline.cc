@@ -7,12 +7,44 @@
 #include "ns3/aodv-module.h"
 #include "ns3/flow-monitor-module.h"
 
+#include "spatial_grid_spectrum_channel.h"
+#include "manet_metrics.h"
+#include "wifi_config.h"
+#include "sim_profiler.h"
+#include "scheduler_config.h"
+
 using namespace ns3;
 
 int main (int argc, char *argv[])
 {
     uint32_t nNodes = 30;
     double simTime = 40.0;
+    std::string profile;
+    std::string wifiStandard = "b";
+    std::string rateControl = "default";
+    std::string dataMode;
+    uint32_t payloadSize = 64;
+    std::string scheduler = "map";
+
+    CommandLine cmd;
+    cmd.AddValue("nNodes", "Number of nodes", nNodes);
+    cmd.AddValue("simTime", "Simulation time (s)", simTime);
+    cmd.AddValue("wifiStandard", "Wi-Fi standard: b, g, n or ac", wifiStandard);
+    cmd.AddValue("rateControl", "Rate control: default, ideal, minstrel-ht or constant", rateControl);
+    cmd.AddValue("dataMode", "Data mode for constant rate control (empty = standard's top rate)", dataMode);
+    cmd.AddValue("payloadSize", "Echo payload size (bytes)", payloadSize);
+    cmd.AddValue("scheduler", "Event scheduler: map, heap, calendar, list or priority", scheduler);
+    cmd.AddValue("profile", "Append a JSON run profile to this file", profile);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(nNodes < 2, "Need at least two nodes");
+    uint32_t serverNode = nNodes - 1;
+
+    SimProfiler profiler;
+    if (!profile.empty())
+        profiler.Enable(GetSchedulerTypeName(scheduler));
+    else
+        ConfigureScheduler(scheduler);
 
     // 1. Create nodes
     NodeContainer nodes;
@@ -38,16 +70,12 @@ int main (int argc, char *argv[])
 
     // 3. WiFi Ad-hoc
     WifiHelper wifi;
-    wifi.SetStandard(WIFI_STANDARD_80211b);
-
-    YansWifiPhyHelper phy;
-    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
-    phy.SetChannel(channel.Create());
+    ConfigureWifi(wifi, wifiStandard, rateControl, dataMode);
 
     WifiMacHelper mac;
     mac.SetType("ns3::AdhocWifiMac");
 
-    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+    NetDeviceContainer devices = InstallAdhocWifi(wifi, mac, nodes, "yans");
 
     // 4. Routing protocol (AODV)
     AodvHelper aodv;
@@ -62,15 +90,15 @@ int main (int argc, char *argv[])
 
     // 6. UDP Echo (traffic)
     UdpEchoServerHelper server(9);
-    ApplicationContainer serverApp = server.Install(nodes.Get(29));
+    ApplicationContainer serverApp = server.Install(nodes.Get(serverNode));
     serverApp.Start(Seconds(1.0));
     serverApp.Stop(Seconds(simTime));
 
-    UdpEchoClientHelper client(interfaces.GetAddress(29), 9);
+    UdpEchoClientHelper client(interfaces.GetAddress(serverNode), 9);
 
     client.SetAttribute("MaxPackets", UintegerValue(50));
     client.SetAttribute("Interval", TimeValue(Seconds(0.5)));
-    client.SetAttribute("PacketSize", UintegerValue(64));
+    client.SetAttribute("PacketSize", UintegerValue(payloadSize));
 
     ApplicationContainer clientApp = client.Install(nodes.Get(1));
     clientApp.Start(Seconds(10.0));
@@ -81,52 +109,33 @@ int main (int argc, char *argv[])
         FlowMonitorHelper flowHelper;
     Ptr<FlowMonitor> flowMonitor = flowHelper.InstallAll();
 
-        Simulator::Run();
+    profiler.BeginPhase("run");
+    Simulator::Run();
+    profiler.CaptureRun();
 
+    profiler.BeginPhase("metrics");
     flowMonitor->CheckForLostPackets();
 
     Ptr<Ipv4FlowClassifier> classifier =
         DynamicCast<Ipv4FlowClassifier>(flowHelper.GetClassifier());
 
-    std::map<FlowId, FlowMonitor::FlowStats> stats = flowMonitor->GetFlowStats();
-
-    double totalTxPackets = 0;
-    double totalRxPackets = 0;
-    double totalDelay = 0;
-    double totalThroughput = 0;
-
-    for (auto const &flow : stats)
-    {
-        Ipv4FlowClassifier::FiveTuple t = classifier->FindFlow(flow.first);
-
-        totalTxPackets += flow.second.txPackets;
-        totalRxPackets += flow.second.rxPackets;
-        totalDelay += flow.second.delaySum.GetSeconds();
-
-        if (flow.second.timeLastRxPacket.GetSeconds() > 0)
-        {
-            double throughput =
-                (flow.second.rxBytes * 8.0) /
-                (flow.second.timeLastRxPacket.GetSeconds() -
-                 flow.second.timeFirstTxPacket.GetSeconds());
-
-            totalThroughput += throughput;
-        }
-    }
-
-    double pdr = (totalTxPackets > 0)? (totalRxPackets / totalTxPackets) * 100.0: 0;
-
-    double avgDelay = (totalRxPackets > 0)? (totalDelay / totalRxPackets): 0;
-
-    std::cout << "\n========== BASELINE MANET METRICS ==========\n";
-    std::cout << "Total Tx Packets: " << totalTxPackets << "\n";
-    std::cout << "Total Rx Packets: " << totalRxPackets << "\n";
-    std::cout << "Packet Delivery Ratio (PDR): " << pdr << " %\n";
-    std::cout << "Average End-to-End Delay: " << avgDelay << " s\n";
-    std::cout << "Aggregate Throughput: " << totalThroughput / 1000 << " kbps\n";
-    std::cout << "===========================================\n";
+    FlowMetrics metrics = ComputeFlowMetrics(flowMonitor, classifier);
+    PrintFlowMetrics("BASELINE MANET METRICS", metrics);
+
+    profiler.EndPhase();
+    profiler.SetLabel("scenario", "baseline");
+    profiler.SetLabel("nNodes", nNodes);
+    profiler.SetLabel("simTime", simTime);
+    profiler.SetLabel("wifiStandard", wifiStandard);
+    profiler.SetLabel("rateControl", rateControl);
+    profiler.SetLabel("payloadSize", payloadSize);
+    profiler.SetLabel("scheduler", scheduler);
+    profiler.SetLabel("pdr", metrics.Pdr());
+    profiler.SetLabel("avgDelay", metrics.AvgDelay());
+    profiler.SetLabel("throughputKbps", metrics.ThroughputKbps());
+    profiler.Print();
+    profiler.Write(profile);
 
-   
     Simulator::Destroy();
 
     return 0;
@@ -7,25 +7,76 @@
 #include "ns3/aodv-module.h"
 #include "ns3/flow-monitor-module.h"
 
+#include "spatial_grid_spectrum_channel.h"
+#include "manet_metrics.h"
+#include "wifi_config.h"
+#include "sim_profiler.h"
+#include "forwarding_attack.h"
+#include "cached_propagation_loss_model.h"
+#include "scheduler_config.h"
+#include "topology_generator.h"
+
 using namespace ns3;
 
-// Fixed malicious node
+// Malicious node of the chain (and of --select=manual)
 uint32_t maliciousNodeId = 5;
 
-// Blackhole: drop all received packets
-bool
-BlackholeReceive(Ptr<NetDevice> device,
-                 Ptr<const Packet> packet,
-                 uint16_t protocol,
-                 const Address &source)
-{
-    return false; // silently drop
-}
-
 int main (int argc, char *argv[])
 {
     uint32_t nNodes = 30;
     double simTime = 40.0;
+    std::string profile;
+    std::string wifiStandard = "b";
+    std::string rateControl = "default";
+    std::string dataMode;
+    uint32_t payloadSize = 64;
+    bool cacheLoss = false;
+    std::string channelMode = "yans";
+    std::string topology = "chain";
+    std::string select = "auto";
+    uint32_t betweennessSamples = 64;
+    uint32_t clients = 1;
+    TopologyGenerator::Params layout;
+    std::string scheduler = "map";
+
+    CommandLine cmd;
+    cmd.AddValue("nNodes", "Number of nodes (at least 6 for the chain)", nNodes);
+    cmd.AddValue("simTime", "Simulation time (s)", simTime);
+    cmd.AddValue("maliciousNodeId", "Blackhole node (chain or --select=manual)", maliciousNodeId);
+    cmd.AddValue("topology", "chain (hand-placed), rgg, grid or corridor", topology);
+    cmd.AddValue("range", "Generated topologies: neighbor range (m)", layout.range);
+    cmd.AddValue("meanDegree", "rgg/corridor: target mean degree", layout.meanDegree);
+    cmd.AddValue("select", "Blackhole choice: auto, manual, degree or betweenness", select);
+    cmd.AddValue("betweennessSamples", "BFS sources for betweenness (0 = exact)", betweennessSamples);
+    cmd.AddValue("clients", "Generated topologies: echo clients", clients);
+    cmd.AddValue("wifiStandard", "Wi-Fi standard: b, g, n or ac", wifiStandard);
+    cmd.AddValue("rateControl", "Rate control: default, ideal, minstrel-ht or constant", rateControl);
+    cmd.AddValue("dataMode", "Data mode for constant rate control (empty = standard's top rate)", dataMode);
+    cmd.AddValue("payloadSize", "Echo payload size (bytes)", payloadSize);
+    cmd.AddValue("cacheLoss", "Memoize propagation loss per node pair (static nodes)", cacheLoss);
+    cmd.AddValue("channelMode", "Wi-Fi channel: yans or grid (spatially culled, for large topologies)",
+                 channelMode);
+    cmd.AddValue("scheduler", "Event scheduler: map, heap, calendar, list or priority", scheduler);
+    cmd.AddValue("profile", "Append a JSON run profile to this file", profile);
+    cmd.Parse(argc, argv);
+
+    bool chain = topology == "chain";
+    if (select == "auto")
+        select = chain ? "manual" : "betweenness";
+
+    NS_ABORT_MSG_IF(chain && nNodes < 6, "The fixed chain needs 6 nodes");
+    NS_ABORT_MSG_IF(!chain && (clients < 1 || clients + 2 > nNodes),
+                    "A generated topology needs a server, " << clients
+                        << " client(s) and a blackhole");
+    // Centrality selections on a generated topology choose the node themselves
+    NS_ABORT_MSG_IF((chain || select == "manual") && maliciousNodeId >= nNodes,
+                    "Malicious node " << maliciousNodeId << " does not exist");
+
+    SimProfiler profiler;
+    if (!profile.empty())
+        profiler.Enable(GetSchedulerTypeName(scheduler));
+    else
+        ConfigureScheduler(scheduler);
 
     // Create nodes
     NodeContainer nodes;
@@ -35,114 +86,170 @@ int main (int argc, char *argv[])
     MobilityHelper mobility;
     mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
 
-    Ptr<ListPositionAllocator> pos = CreateObject<ListPositionAllocator>();
+    uint32_t serverNode = 0;
+    std::vector<uint32_t> clientNodes{1};
 
-    // Linear chain forcing node 5 in the path
-   pos->Add(Vector(0.0,    0.0, 0.0));   // node 0
-pos->Add(Vector(300.0,  0.0, 0.0));   // node 1
-pos->Add(Vector(600.0,  0.0, 0.0));   // node 2
-pos->Add(Vector(900.0,  0.0, 0.0));   // node 3
-pos->Add(Vector(1200.0, 0.0, 0.0));   // node 4
-pos->Add(Vector(1500.0, 0.0, 0.0));   // node 5 (BLACKHOLE)
+    if (chain)
+    {
+        Ptr<ListPositionAllocator> pos = CreateObject<ListPositionAllocator>();
 
+        // Linear chain forcing node 5 in the path
+        pos->Add(Vector(0.0,    0.0, 0.0));   // node 0
+        pos->Add(Vector(300.0,  0.0, 0.0));   // node 1
+        pos->Add(Vector(600.0,  0.0, 0.0));   // node 2
+        pos->Add(Vector(900.0,  0.0, 0.0));   // node 3
+        pos->Add(Vector(1200.0, 0.0, 0.0));   // node 4
+        pos->Add(Vector(1500.0, 0.0, 0.0));   // node 5 (BLACKHOLE)
 
-    for (uint32_t i = 6; i < nNodes; ++i)
-    {
-        pos->Add(Vector(300 + i * 20, 0.0, 0.0));
+        for (uint32_t i = 6; i < nNodes; ++i)
+        {
+            pos->Add(Vector(300 + i * 20, 0.0, 0.0));
+        }
+
+        mobility.SetPositionAllocator(pos);
     }
+    else
+    {
+        // Server and first client at the two ends of a longest path
+        layout.layout = topology;
+        TopologyGenerator generator(layout);
+        generator.Generate(nNodes);
+        mobility.SetPositionAllocator(generator.GetPositionAllocator());
+
+        serverNode = generator.FarthestFrom(0);
+        clientNodes = {generator.FarthestFrom(serverNode)};
+        std::set<uint32_t> endpoints{serverNode, clientNodes[0]};
+
+        Ptr<UniformRandomVariable> pick = CreateObject<UniformRandomVariable>();
+        while (clientNodes.size() < clients)
+        {
+            uint32_t node = pick->GetInteger(0, nNodes - 1);
+            if (endpoints.insert(node).second)
+                clientNodes.push_back(node);
+        }
+
+        if (select != "manual")
+        {
+            std::vector<double> scores = generator.Centrality(select, betweennessSamples);
+            maliciousNodeId = TopologyGenerator::MostCentral(scores, endpoints);
+        }
+        NS_ABORT_MSG_IF(endpoints.count(maliciousNodeId),
+                        "Node " << maliciousNodeId << " is the server or a client");
+
+        generator.PrintSummary();
 
-    mobility.SetPositionAllocator(pos);
+        // On a shortest path between the first client and the server?
+        std::vector<uint32_t> fromServer = generator.HopDistances(serverNode);
+        std::vector<uint32_t> fromClient = generator.HopDistances(clientNodes[0]);
+        bool onPath = fromServer[maliciousNodeId] + fromClient[maliciousNodeId] ==
+                      fromServer[clientNodes[0]];
+
+        std::cout << "[INFO] Server " << serverNode << ", first client " << clientNodes[0]
+                  << " (" << fromServer[clientNodes[0]] << " hops), blackhole " << maliciousNodeId
+                  << " by " << select << " (degree " << generator.GetNeighbors(maliciousNodeId).size()
+                  << (onPath ? ", on a shortest path" : ", off the shortest paths") << ")\n";
+    }
     mobility.Install(nodes);
 
     // ---------- WIFI AD-HOC ----------
     WifiHelper wifi;
-    wifi.SetStandard(WIFI_STANDARD_80211b);
-
-    YansWifiPhyHelper phy;
-    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
-    phy.SetChannel(channel.Create());
+    ConfigureWifi(wifi, wifiStandard, rateControl, dataMode);
 
     WifiMacHelper mac;
     mac.SetType("ns3::AdhocWifiMac");
 
-    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+    // Nodes never move, so every pair's loss only has to be computed once
+    Ptr<CachedPropagationLossModel> lossCache;
+    if (cacheLoss)
+        lossCache = CreateObject<CachedPropagationLossModel>();
+
+    Ptr<SpatialGridSpectrumChannel> gridChannel;
+    NetDeviceContainer devices =
+        InstallAdhocWifi(wifi, mac, nodes, channelMode, &gridChannel, lossCache);
+    if (gridChannel)
+        gridChannel->SetAttribute("MaxSpeed", DoubleValue(0.0));   // static: no drift slack
 
     // ---------- ROUTING ----------
+    // AODV inside a routing list so the attack filter can sit above it
     AodvHelper aodv;
+    Ipv4ListRoutingHelper routing;
+    routing.Add(aodv, 10);
+
     InternetStackHelper internet;
-    internet.SetRoutingHelper(aodv);
+    internet.SetRoutingHelper(routing);
     internet.Install(nodes);
 
     // ---------- IP ADDRESSING ----------
     Ipv4AddressHelper ipv4;
-    ipv4.SetBase("10.0.0.0", "255.255.255.0");
+    ipv4.SetBase("10.0.0.0", "255.255.0.0");
     Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
 
     // ---------- TRAFFIC ----------
     UdpEchoServerHelper server(9);
-    ApplicationContainer serverApp = server.Install(nodes.Get(0));
+    ApplicationContainer serverApp = server.Install(nodes.Get(serverNode));
     serverApp.Start(Seconds(1.0));
     serverApp.Stop(Seconds(simTime));
 
-    UdpEchoClientHelper client(interfaces.GetAddress(0), 9);
+    UdpEchoClientHelper client(interfaces.GetAddress(serverNode), 9);
     client.SetAttribute("MaxPackets", UintegerValue(50));
     client.SetAttribute("Interval", TimeValue(Seconds(0.5)));
-    client.SetAttribute("PacketSize", UintegerValue(64));
+    client.SetAttribute("PacketSize", UintegerValue(payloadSize));
 
-    ApplicationContainer clientApp = client.Install(nodes.Get(1));
+    ApplicationContainer clientApp;
+    for (uint32_t node : clientNodes)
+        clientApp.Add(client.Install(nodes.Get(node)));
     clientApp.Start(Seconds(10.0)); // allow route convergence
     clientApp.Stop(Seconds(simTime));
 
     // ---------- BLACKHOLE ATTACK ----------
-    Ptr<Node> maliciousNode = nodes.Get(maliciousNodeId);
-    for (uint32_t i = 0; i < maliciousNode->GetNDevices(); ++i)
-    {
-        Ptr<NetDevice> dev = maliciousNode->GetDevice(i);
-        dev->SetReceiveCallback(MakeCallback(&BlackholeReceive));
-    }
+    // Drops every packet it should forward; its own AODV traffic is untouched
+    Ptr<ForwardingAttackFilter> blackhole =
+        InstallForwardingAttackFilter(nodes.Get(maliciousNodeId), 1.0);
+    blackhole->SetActive(true);
 
     // ---------- FLOW MONITOR ----------
     FlowMonitorHelper flowHelper;
     Ptr<FlowMonitor> flowMonitor = flowHelper.InstallAll();
 
     Simulator::Stop(Seconds(simTime));
+    profiler.BeginPhase("run");
     Simulator::Run();
+    profiler.CaptureRun();
 
     // ---------- METRICS ----------
+    profiler.BeginPhase("metrics");
     flowMonitor->CheckForLostPackets();
 
     Ptr<Ipv4FlowClassifier> classifier =
         DynamicCast<Ipv4FlowClassifier>(flowHelper.GetClassifier());
 
-    auto stats = flowMonitor->GetFlowStats();
-
-    double tx = 0, rx = 0, delay = 0, throughput = 0;
-
-    for (const auto &flow : stats)
-    {
-        tx += flow.second.txPackets;
-        rx += flow.second.rxPackets;
-        delay += flow.second.delaySum.GetSeconds();
-
-        if (flow.second.timeLastRxPacket.GetSeconds() > 0)
-        {
-            throughput +=
-                (flow.second.rxBytes * 8.0) /
-                (flow.second.timeLastRxPacket.GetSeconds() -
-                 flow.second.timeFirstTxPacket.GetSeconds());
-        }
-    }
-
-    double pdr = (tx > 0) ? (rx / tx) * 100.0 : 0.0;
-    double avgDelay = (rx > 0) ? (delay / rx) : 0.0;
-
-    std::cout << "\n========== FIXED-NODE BLACKHOLE METRICS ==========\n";
-    std::cout << "Total Tx Packets: " << tx << "\n";
-    std::cout << "Total Rx Packets: " << rx << "\n";
-    std::cout << "Packet Delivery Ratio (PDR): " << pdr << " %\n";
-    std::cout << "Average End-to-End Delay: " << avgDelay << " s\n";
-    std::cout << "Aggregate Throughput: " << throughput / 1000 << " kbps\n";
-    std::cout << "=================================================\n";
+    FlowMetrics metrics = ComputeFlowMetrics(flowMonitor, classifier);
+    PrintFlowMetrics(chain ? "FIXED-NODE BLACKHOLE METRICS" : "GENERATED TOPOLOGY BLACKHOLE METRICS", metrics);
+
+    std::cout << "[INFO] Node " << maliciousNodeId << " dropped "
+              << blackhole->GetDroppedPackets() << " of "
+              << blackhole->GetTransitPackets() << " transit packets\n";
+
+    PrintGridChannelStats(gridChannel);
+    PrintLossCacheStats(lossCache);
+
+    profiler.EndPhase();
+    profiler.SetLabel("scenario", "blackhole");
+    profiler.SetLabel("nNodes", nNodes);
+    profiler.SetLabel("topology", topology);
+    profiler.SetLabel("channelMode", channelMode);
+    profiler.SetLabel("select", select);
+    profiler.SetLabel("simTime", simTime);
+    profiler.SetLabel("wifiStandard", wifiStandard);
+    profiler.SetLabel("rateControl", rateControl);
+    profiler.SetLabel("payloadSize", payloadSize);
+    profiler.SetLabel("scheduler", scheduler);
+    profiler.SetLabel("cacheLoss", cacheLoss ? 1.0 : 0.0);
+    profiler.SetLabel("pdr", metrics.Pdr());
+    profiler.SetLabel("avgDelay", metrics.AvgDelay());
+    profiler.SetLabel("throughputKbps", metrics.ThroughputKbps());
+    profiler.Print();
+    profiler.Write(profile);
 
     Simulator::Destroy();
     return 0;
@@ -0,0 +1,76 @@
+#ifndef MANET_METRICS_H
+#define MANET_METRICS_H
+
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/flow-monitor-module.h"
+
+#include <functional>
+#include <iostream>
+
+namespace ns3
+{
+
+/*
+ FlowMonitor summary shared by every scenario
+ - PDR = rx / tx packets over all flows
+ - Avg delay = delaySum / rx packets
+ - Throughput = sum over flows of rxBytes * 8 / (lastRx - firstTx)
+*/
+struct FlowMetrics
+{
+    double txPackets = 0;
+    double rxPackets = 0;
+    double delaySum = 0;
+    double throughput = 0;   // bit/s
+
+    double Pdr() const { return (txPackets > 0) ? (rxPackets / txPackets) * 100.0 : 0.0; }
+    double AvgDelay() const { return (rxPackets > 0) ? (delaySum / rxPackets) : 0.0; }
+    double ThroughputKbps() const { return throughput / 1000; }
+};
+
+// Only flows accepted by the filter are counted (all flows by default)
+typedef std::function<bool(const Ipv4FlowClassifier::FiveTuple &)> FlowFilter;
+
+inline FlowMetrics
+ComputeFlowMetrics(Ptr<FlowMonitor> flowMonitor,
+                   Ptr<Ipv4FlowClassifier> classifier,
+                   FlowFilter filter = FlowFilter())
+{
+    FlowMetrics m;
+
+    for (const auto &flow : flowMonitor->GetFlowStats())
+    {
+        if (filter && !filter(classifier->FindFlow(flow.first)))
+            continue;
+
+        m.txPackets += flow.second.txPackets;
+        m.rxPackets += flow.second.rxPackets;
+        m.delaySum += flow.second.delaySum.GetSeconds();
+
+        if (flow.second.timeLastRxPacket.GetSeconds() > 0)
+        {
+            m.throughput +=
+                (flow.second.rxBytes * 8.0) /
+                (flow.second.timeLastRxPacket.GetSeconds() -
+                 flow.second.timeFirstTxPacket.GetSeconds());
+        }
+    }
+    return m;
+}
+
+inline void
+PrintFlowMetrics(const std::string &title, const FlowMetrics &m)
+{
+    std::cout << "\n===== " << title << " =====\n";
+    std::cout << "Tx Packets: " << m.txPackets << "\n";
+    std::cout << "Rx Packets: " << m.rxPackets << "\n";
+    std::cout << "PDR: " << m.Pdr() << " %\n";
+    std::cout << "Avg Delay: " << m.AvgDelay() << " s\n";
+    std::cout << "Throughput: " << m.ThroughputKbps() << " kbps\n";
+    std::cout << std::string(title.size() + 12, '=') << "\n";
+}
+
+} // namespace ns3
+
+#endif /* MANET_METRICS_H */
@@ -0,0 +1,504 @@
+#include "ns3/core-module.h"
+
+#include "scheduler_config.h"
+
+#include <malloc.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+/*
+ SCHEDULER BENCHMARK
+ - Replays the event pattern of the swarm scenarios without the models
+   behind it, so the event scheduler is the only thing being measured:
+     mobility  one tick per node every mobilityInterval (2 s)
+     heartbeat every follower every heartbeatInterval (2 s), relayed over
+               hops unicast hops towards the leader
+     hello     one AODV-style broadcast per node every helloInterval
+     frame     802.11b-like exchange per transmission: DIFS + random
+               backoff (sometimes cancelled by a busy channel and
+               restarted), TxEnd, RxEnd at every neighbor, SIFS + ACK
+               for unicast, and an ACK timeout that is cancelled when the
+               ACK arrives (lazily, as Wi-Fi timers are)
+ - The pattern is drawn from a fixed seed, so every scheduler replays the
+   same events. Each (scheduler, nodes) pair runs twice:
+     speed   the bare scheduler; events per second of wall time
+     memory  wrapped in a counter of pending events (cancelled ones
+             included, they stay queued until due); bytes per pending
+             event = heap growth at the peak / peak pending count, event
+             objects included
+ - e.g.
+     ./ns3 run "manet_scheduler_bench --nNodes=10,100,1000,2000"
+     ./ns3 run "manet_scheduler_bench --scheduler=heap,calendar --simTime=30"
+*/
+
+// ----- Heap accounting (memory pass only) -----
+static bool g_trackHeap = false;
+static int64_t g_liveBytes = 0;
+
+void *
+operator new(std::size_t size)
+{
+    void *p = std::malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    if (g_trackHeap)
+        g_liveBytes += malloc_usable_size(p);
+    return p;
+}
+
+void
+operator delete(void *p) noexcept
+{
+    if (!p)
+        return;
+    if (g_trackHeap)
+        g_liveBytes -= malloc_usable_size(p);
+    std::free(p);
+}
+
+void
+operator delete(void *p, std::size_t) noexcept
+{
+    operator delete(p);
+}
+
+/*
+ Pending-event counter
+ - Forwards to InnerType like ProfilingScheduler and keeps the number of
+   queued events, its peak, and the live heap bytes at that peak
+*/
+class PendingCountingScheduler : public Scheduler
+{
+  public:
+    static TypeId GetTypeId();
+
+    static void Reset()
+    {
+        s_pending = 0;
+        s_peak = 0;
+        s_peakBytes = 0;
+    }
+    static uint64_t GetPeak() { return s_peak; }
+    static int64_t GetPeakBytes() { return s_peakBytes; }
+
+    void Insert(const Event &ev) override
+    {
+        m_inner->Insert(ev);
+        if (++s_pending > s_peak)
+        {
+            s_peak = s_pending;
+            s_peakBytes = g_liveBytes;
+        }
+    }
+    bool IsEmpty() const override { return m_inner->IsEmpty(); }
+    Event PeekNext() const override { return m_inner->PeekNext(); }
+    Event RemoveNext() override
+    {
+        --s_pending;
+        return m_inner->RemoveNext();
+    }
+    void Remove(const Event &ev) override
+    {
+        --s_pending;
+        m_inner->Remove(ev);
+    }
+
+  private:
+    void SetInnerType(std::string type)
+    {
+        ObjectFactory factory;
+        factory.SetTypeId(type);
+        m_inner = factory.Create<Scheduler>();
+        m_innerType = type;
+    }
+    std::string GetInnerType() const { return m_innerType; }
+
+    std::string m_innerType;
+    Ptr<Scheduler> m_inner;
+
+    static uint64_t s_pending;
+    static uint64_t s_peak;
+    static int64_t s_peakBytes;
+};
+
+uint64_t PendingCountingScheduler::s_pending = 0;
+uint64_t PendingCountingScheduler::s_peak = 0;
+int64_t PendingCountingScheduler::s_peakBytes = 0;
+
+NS_OBJECT_ENSURE_REGISTERED(PendingCountingScheduler);
+
+TypeId
+PendingCountingScheduler::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::PendingCountingScheduler")
+            .SetParent<Scheduler>()
+            .SetGroupName("Core")
+            .AddConstructor<PendingCountingScheduler>()
+            .AddAttribute("InnerType",
+                          "TypeId of the scheduler that actually orders events",
+                          StringValue("ns3::MapScheduler"),
+                          MakeStringAccessor(&PendingCountingScheduler::SetInnerType,
+                                             &PendingCountingScheduler::GetInnerType),
+                          MakeStringChecker());
+    return tid;
+}
+
+// ----- Swarm event pattern -----
+class SwarmEventReplay
+{
+  public:
+    struct Params
+    {
+        double mobilityInterval = 2.0;
+        double heartbeatInterval = 2.0;
+        double helloInterval = 1.0;     // 0 = no hellos
+        uint32_t hops = 2;              // unicast hops per heartbeat
+        uint32_t neighbors = 10;        // receivers per transmission
+        uint32_t payloadSize = 64;
+        double busyProbability = 0.3;   // backoff interrupted by a busy channel
+        double lossProbability = 0.05;  // frame lost, ACK timeout fires
+        uint32_t seed = 1;
+    };
+
+    SwarmEventReplay(uint32_t nNodes, const Params &params);
+
+    // Schedules every node's first tick, heartbeat and hello
+    void Start();
+
+  private:
+    double Uniform(double lo, double hi)
+    {
+        return std::uniform_real_distribution<double>(lo, hi)(m_rng);
+    }
+    Time BackoffDelay() { return m_difs + m_slot * std::uniform_int_distribution<int>(0, 31)(m_rng); }
+
+    void MobilityTick(uint32_t node);
+    void Heartbeat(uint32_t node);
+    void Hello(uint32_t node);
+
+    // hops = 0 is a broadcast (no ACK)
+    void StartBackoff(uint32_t node, uint32_t hops);
+    void ChannelBusy(uint32_t node, uint32_t hops);
+    void BackoffExpired(uint32_t node, uint32_t hops);
+    void TxEnd(uint32_t node);
+    void RxEnd(uint32_t node, uint32_t from, uint32_t hops);
+    void AckTx(uint32_t node, uint32_t from, uint32_t hops);
+    void AckRx(uint32_t node);
+    void AckTimeout(uint32_t node);
+
+    uint32_t m_nNodes;
+    Params m_params;
+    std::mt19937 m_rng;
+
+    Time m_slot = MicroSeconds(20);
+    Time m_sifs = MicroSeconds(10);
+    Time m_difs = MicroSeconds(50);
+    Time m_ackTime = MicroSeconds(304);   // long preamble, 1 Mbps
+    Time m_airtime;
+
+    std::vector<EventId> m_backoff;
+    std::vector<EventId> m_ackTimeout;
+    std::vector<double> m_heading;
+    std::vector<bool> m_busy;
+};
+
+SwarmEventReplay::SwarmEventReplay(uint32_t nNodes, const Params &params)
+    : m_nNodes(nNodes),
+      m_params(params),
+      m_rng(params.seed),
+      m_backoff(nNodes),
+      m_ackTimeout(nNodes),
+      m_heading(nNodes, 0.0),
+      m_busy(nNodes, false)
+{
+    // 192 us long preamble, then UDP/IP + MAC/FCS overhead at 1 Mbps
+    m_airtime = MicroSeconds(192 + (params.payloadSize + 28 + 36) * 8);
+    m_params.neighbors = std::min(m_params.neighbors, nNodes - 1);
+}
+
+void
+SwarmEventReplay::Start()
+{
+    for (uint32_t i = 0; i < m_nNodes; ++i)
+    {
+        Simulator::Schedule(Seconds(Uniform(0.0, m_params.mobilityInterval)),
+                            &SwarmEventReplay::MobilityTick, this, i);
+        if (m_params.helloInterval > 0.0)
+        {
+            Simulator::Schedule(Seconds(Uniform(0.0, m_params.helloInterval)),
+                                &SwarmEventReplay::Hello, this, i);
+        }
+        if (i > 0)
+        {
+            Simulator::Schedule(Seconds(Uniform(0.0, m_params.heartbeatInterval)),
+                                &SwarmEventReplay::Heartbeat, this, i);
+        }
+    }
+}
+
+void
+SwarmEventReplay::MobilityTick(uint32_t node)
+{
+    m_heading[node] += Uniform(-0.1, 0.1);
+    Simulator::Schedule(Seconds(m_params.mobilityInterval), &SwarmEventReplay::MobilityTick, this,
+                        node);
+}
+
+void
+SwarmEventReplay::Heartbeat(uint32_t node)
+{
+    Simulator::Schedule(Seconds(m_params.heartbeatInterval), &SwarmEventReplay::Heartbeat, this,
+                        node);
+    StartBackoff(node, std::max(m_params.hops, 1u));
+}
+
+void
+SwarmEventReplay::Hello(uint32_t node)
+{
+    Simulator::Schedule(Seconds(m_params.helloInterval), &SwarmEventReplay::Hello, this, node);
+    StartBackoff(node, 0);
+}
+
+void
+SwarmEventReplay::StartBackoff(uint32_t node, uint32_t hops)
+{
+    Time delay = BackoffDelay();
+    m_backoff[node] = Simulator::Schedule(delay, &SwarmEventReplay::BackoffExpired, this, node, hops);
+
+    if (Uniform(0.0, 1.0) < m_params.busyProbability)
+    {
+        Simulator::Schedule(NanoSeconds(uint64_t(Uniform(0.0, delay.GetNanoSeconds()))),
+                            &SwarmEventReplay::ChannelBusy, this, node, hops);
+    }
+}
+
+void
+SwarmEventReplay::ChannelBusy(uint32_t node, uint32_t hops)
+{
+    // Freeze the countdown and resume once the other frame is over
+    m_backoff[node].Cancel();
+    m_backoff[node] = Simulator::Schedule(m_airtime + BackoffDelay(),
+                                          &SwarmEventReplay::BackoffExpired, this, node, hops);
+}
+
+void
+SwarmEventReplay::BackoffExpired(uint32_t node, uint32_t hops)
+{
+    m_busy[node] = true;
+    Simulator::Schedule(m_airtime, &SwarmEventReplay::TxEnd, this, node);
+
+    for (uint32_t j = 0; j < m_params.neighbors; ++j)
+    {
+        uint32_t receiver = (node + 1 + j) % m_nNodes;
+        Simulator::Schedule(m_airtime + NanoSeconds(10 * (j + 1)), &SwarmEventReplay::RxEnd, this,
+                            receiver, node, j == 0 ? hops : 0);
+    }
+
+    if (hops > 0)
+    {
+        m_ackTimeout[node] = Simulator::Schedule(m_airtime + m_sifs + m_ackTime + m_slot,
+                                                 &SwarmEventReplay::AckTimeout, this, node);
+    }
+}
+
+void
+SwarmEventReplay::TxEnd(uint32_t node)
+{
+    m_busy[node] = false;
+}
+
+void
+SwarmEventReplay::RxEnd(uint32_t node, uint32_t from, uint32_t hops)
+{
+    if (hops == 0 || Uniform(0.0, 1.0) < m_params.lossProbability)
+        return;
+    Simulator::Schedule(m_sifs, &SwarmEventReplay::AckTx, this, node, from, hops);
+}
+
+void
+SwarmEventReplay::AckTx(uint32_t node, uint32_t from, uint32_t hops)
+{
+    Simulator::Schedule(m_ackTime, &SwarmEventReplay::AckRx, this, from);
+
+    // Relay towards the leader
+    if (hops > 1)
+        StartBackoff(node, hops - 1);
+}
+
+void
+SwarmEventReplay::AckRx(uint32_t node)
+{
+    m_ackTimeout[node].Cancel();
+}
+
+void
+SwarmEventReplay::AckTimeout(uint32_t node)
+{
+    m_busy[node] = false;
+}
+
+// ----- One pass -----
+struct PassResult
+{
+    uint64_t events = 0;
+    double wallSeconds = 0.0;
+    uint64_t peakPending = 0;
+    double bytesPerEvent = 0.0;
+};
+
+static PassResult
+RunPass(const std::string &scheduler,
+        uint32_t nNodes,
+        double simTime,
+        const SwarmEventReplay::Params &params,
+        bool memory)
+{
+    PassResult result;
+    SwarmEventReplay replay(nNodes, params);
+
+    int64_t baseline = 0;
+    if (memory)
+    {
+        g_trackHeap = true;
+        g_liveBytes = 0;
+        PendingCountingScheduler::Reset();
+
+        ObjectFactory factory;
+        factory.SetTypeId("ns3::PendingCountingScheduler");
+        factory.Set("InnerType", StringValue(GetSchedulerTypeName(scheduler)));
+        Simulator::SetScheduler(factory);
+        baseline = g_liveBytes;
+    }
+    else
+    {
+        ConfigureScheduler(scheduler);
+    }
+
+    replay.Start();
+    Simulator::Stop(Seconds(simTime));
+
+    auto wallStart = std::chrono::steady_clock::now();
+    Simulator::Run();
+    result.wallSeconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    result.events = Simulator::GetEventCount();
+
+    if (memory)
+    {
+        result.peakPending = PendingCountingScheduler::GetPeak();
+        if (result.peakPending > 0)
+        {
+            result.bytesPerEvent =
+                double(PendingCountingScheduler::GetPeakBytes() - baseline) / result.peakPending;
+        }
+    }
+
+    Simulator::Destroy();
+    g_trackHeap = false;
+    return result;
+}
+
+template <typename T>
+static std::vector<T>
+ParseList(const std::string &text)
+{
+    std::vector<T> values;
+    std::istringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ','))
+    {
+        if (item.empty())
+            continue;
+        std::istringstream value(item);
+        T v;
+        value >> v;
+        values.push_back(v);
+    }
+    return values;
+}
+
+int main(int argc, char *argv[])
+{
+    std::string nodeList = "10,50,200,500,1000,2000";
+    std::string schedulerList = "map,heap,calendar,list,priority";
+    double simTime = 10.0;
+    SwarmEventReplay::Params params;
+
+    CommandLine cmd;
+    cmd.AddValue("nNodes", "Comma-separated swarm sizes", nodeList);
+    cmd.AddValue("scheduler", "Comma-separated schedulers (map, heap, calendar, list, priority)",
+                 schedulerList);
+    cmd.AddValue("simTime", "Simulated time per run (s)", simTime);
+    cmd.AddValue("mobilityInterval", "Mobility tick interval (s)", params.mobilityInterval);
+    cmd.AddValue("heartbeatInterval", "Follower heartbeat interval (s)", params.heartbeatInterval);
+    cmd.AddValue("helloInterval", "Broadcast hello interval (s, 0 = none)", params.helloInterval);
+    cmd.AddValue("hops", "Unicast hops per heartbeat", params.hops);
+    cmd.AddValue("neighbors", "Receivers per transmission", params.neighbors);
+    cmd.AddValue("payloadSize", "Heartbeat payload (bytes), sets the frame airtime",
+                 params.payloadSize);
+    cmd.AddValue("busyProbability", "Chance a backoff is interrupted by a busy channel",
+                 params.busyProbability);
+    cmd.AddValue("lossProbability", "Chance a unicast frame is lost (ACK timeout fires)",
+                 params.lossProbability);
+    cmd.AddValue("seed", "Seed of the replayed pattern", params.seed);
+    cmd.Parse(argc, argv);
+
+    std::vector<uint32_t> sizes = ParseList<uint32_t>(nodeList);
+    std::vector<std::string> schedulers = ParseList<std::string>(schedulerList);
+    NS_ABORT_MSG_IF(sizes.empty() || schedulers.empty(), "Nothing to run");
+    for (uint32_t n : sizes)
+        NS_ABORT_MSG_IF(n < 2, "A swarm needs at least two nodes");
+    for (const std::string &s : schedulers)
+        GetSchedulerTypeName(s);   // aborts on an unknown name
+
+    std::cout << "\n===== SCHEDULER BENCHMARK =====\n";
+    std::cout << "Simulated time: " << simTime << " s per run, seed " << params.seed << "\n";
+    std::cout << std::left << std::setw(10) << "Scheduler"
+              << std::right << std::setw(7) << "Nodes"
+              << std::setw(12) << "Events"
+              << std::setw(10) << "Wall (s)"
+              << std::setw(14) << "Events/s"
+              << std::setw(10) << "Pending"
+              << std::setw(12) << "B/pending" << std::endl;
+
+    std::map<uint32_t, std::pair<std::string, double>> fastest;
+    for (uint32_t n : sizes)
+    {
+        for (const std::string &s : schedulers)
+        {
+            PassResult speed = RunPass(s, n, simTime, params, false);
+            PassResult memory = RunPass(s, n, simTime, params, true);
+            double rate = speed.wallSeconds > 0 ? speed.events / speed.wallSeconds : 0.0;
+
+            std::cout << std::left << std::setw(10) << s
+                      << std::right << std::setw(7) << n
+                      << std::setw(12) << speed.events
+                      << std::setw(10) << std::fixed << std::setprecision(3) << speed.wallSeconds
+                      << std::setw(14) << std::setprecision(0) << rate
+                      << std::setw(10) << memory.peakPending
+                      << std::setw(12) << std::setprecision(1) << memory.bytesPerEvent
+                      << std::defaultfloat << std::setprecision(6) << std::endl;
+
+            if (rate > fastest[n].second)
+                fastest[n] = {s, rate};
+        }
+    }
+
+    std::cout << "Fastest:";
+    for (const auto &entry : fastest)
+        std::cout << " " << entry.first << " nodes " << entry.second.first << ";";
+    std::cout << "\n===============================\n";
+    return 0;
+}
@@ -0,0 +1,347 @@
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/flow-monitor-module.h"
+
+#include "swarm_formation.h"
+#include "formation_follower_mobility_model.h"
+#include "manet_metrics.h"
+
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#include <mpi.h>
+#endif
+
+#include <chrono>
+#include <cmath>
+#include <sstream>
+
+using namespace ns3;
+
+/*
+ DISTRIBUTED SWARM: multi-unit patrol under the ns-3 MPI simulator
+ - nUnits leader+follower units of 7 nodes (default 10 units = 70 nodes)
+ - Each unit is one logical process: all its nodes share a systemId
+   (unit % ranks) and the unit has its own Wi-Fi channel
+ - Unit leaders are linked to the command leader (unit 0) by
+   point-to-point backbone links. These are the only channels that
+   cross ranks, and their delay is the synchronization lookahead
+ - Leaders send a status report to the command leader every second
+ - Build ns-3 with --enable-mpi, then:
+     mpirun -np 4 ./ns3 run "manet_swarm_mpi --nUnits=10"
+   and compare the printed Run() wall time with --distributed=0
+*/
+
+// ----- Swarm globals -----
+double patrolSize=300.0; //300X300 area
+double patrolSpeed=10.0;//m/s
+
+struct SwarmUnit
+{
+    Ptr<Node> leader;
+    NodeContainer followers;
+    Vector origin;
+    SwarmFormation formation;
+};
+
+std::vector<SwarmUnit> units;
+
+// ----- Formation switching -----
+void
+SwitchFormation(std::vector<Vector> table)
+{
+    for (auto &u : units)
+        u.formation.SetOffsets(table);
+}
+
+// ----- Leader velocity control -----
+void
+SetLeaderVelocity(Ptr<Node> leader, Vector v)
+{
+    leader->GetObject<ConstantVelocityMobilityModel>()->SetVelocity(v);
+}
+
+// ----- Cross-unit report counters (rank-local) -----
+uint64_t reportsSent = 0;
+uint64_t reportsAcked = 0;
+
+void ReportTx(Ptr<const Packet>) { ++reportsSent; }
+void ReportRx(Ptr<const Packet>) { ++reportsAcked; }
+
+int main(int argc, char *argv[])
+{
+    uint32_t nUnits = 10;
+    uint32_t unitSize = 7;
+    double simTime = 90.0;
+    bool distributed = true;
+    bool nullmsg = false;
+    std::string lookahead = "5ms";
+
+    CommandLine cmd;
+    cmd.AddValue("nUnits", "Number of leader+follower units", nUnits);
+    cmd.AddValue("simTime", "Simulation time (s)", simTime);
+    cmd.AddValue("distributed", "Use the MPI simulator when available", distributed);
+    cmd.AddValue("nullmsg", "Use null-message instead of granted-time-window sync", nullmsg);
+    cmd.AddValue("lookahead", "Backbone link delay (the MPI lookahead)", lookahead);
+    cmd.Parse(argc, argv);
+
+    uint32_t systemId = 0;
+    uint32_t systemCount = 1;
+
+#ifdef NS3_MPI
+    if (distributed)
+    {
+        GlobalValue::Bind("SimulatorImplementationType",
+                          StringValue(nullmsg ? "ns3::NullMessageSimulatorImpl"
+                                              : "ns3::DistributedSimulatorImpl"));
+        MpiInterface::Enable(&argc, &argv);
+        systemId = MpiInterface::GetSystemId();
+        systemCount = MpiInterface::GetSize();
+    }
+#else
+    if (distributed)
+    {
+        std::cout << "[INFO] ns-3 built without MPI, running serially\n";
+    }
+#endif
+
+    // ----- Units: one logical process each -----
+    // Every rank creates every node; a node only runs on the rank that
+    // owns its systemId, the rest are ghosts
+    NodeContainer allNodes;
+    NodeContainer localNodes;
+    units.resize(nUnits);
+
+    uint32_t gridWidth = std::ceil(std::sqrt(nUnits));
+    double unitSpacing = patrolSize + 300.0;
+
+    for (uint32_t u = 0; u < nUnits; ++u)
+    {
+        NodeContainer unitNodes;
+        unitNodes.Create(unitSize, u % systemCount);
+
+        units[u].leader = unitNodes.Get(0);
+        for (uint32_t i = 1; i < unitSize; ++i)
+            units[u].followers.Add(unitNodes.Get(i));
+        units[u].origin = Vector((u % gridWidth) * unitSpacing,
+                                 (u / gridWidth) * unitSpacing, 0.0);
+
+        allNodes.Add(unitNodes);
+        if (u % systemCount == systemId)
+            localNodes.Add(unitNodes);
+    }
+
+    // ----- Mobility -----
+    MobilityHelper mobility;
+    for (const auto &u : units)
+    {
+        mobility.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
+        mobility.Install(u.leader);
+
+        // Followers compute their position from the leader on demand
+        mobility.SetMobilityModel("ns3::FormationFollowerMobilityModel",
+                                  "Lag", TimeValue(Seconds(2.0)));
+        mobility.Install(u.followers);
+    }
+
+    for (uint32_t u = 0; u < nUnits; ++u)
+    {
+        units[u].leader->GetObject<MobilityModel>()->SetPosition(units[u].origin);
+        units[u].formation.Attach(units[u].leader, units[u].followers);
+        units[u].formation.SetOffsets(TightFormationOffsets());
+        BindFormationFollowers(units[u].formation, units[u].leader, units[u].followers);
+
+        if (u % systemCount != systemId)
+            continue;
+
+        Ptr<Node> leader = units[u].leader;
+
+        // Leader patrol: 300x300 square around the unit's origin
+        Simulator::Schedule(Seconds(0.0),
+            &SetLeaderVelocity, leader, Vector(patrolSpeed, 0.0, 0.0));   // Right
+        Simulator::Schedule(Seconds(patrolSize / patrolSpeed),
+            &SetLeaderVelocity, leader, Vector(0.0, patrolSpeed, 0.0));   // Up
+        Simulator::Schedule(Seconds(2 * patrolSize / patrolSpeed),
+            &SetLeaderVelocity, leader, Vector(-patrolSpeed, 0.0, 0.0));  // Left
+        Simulator::Schedule(Seconds(3 * patrolSize / patrolSpeed),
+            &SetLeaderVelocity, leader, Vector(0.0, -patrolSpeed, 0.0));  // Down
+    }
+
+    // Formation dynamics
+    Simulator::Schedule(Seconds(30.0), &SwitchFormation, WideFormationOffsets());
+    Simulator::Schedule(Seconds(60.0), &SwitchFormation, TightFormationOffsets());
+
+    // ----- Wi-Fi ad-hoc, one channel per unit -----
+    // A wireless channel cannot span ranks, so each unit keeps its own
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211b);
+
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+
+    YansWifiPhyHelper phy;
+
+    std::vector<NetDeviceContainer> unitDevices(nUnits);
+    for (uint32_t u = 0; u < nUnits; ++u)
+    {
+        phy.SetChannel(YansWifiChannelHelper::Default().Create());
+
+        NodeContainer unitNodes(units[u].leader);
+        unitNodes.Add(units[u].followers);
+        unitDevices[u] = wifi.Install(phy, mac, unitNodes);
+    }
+
+    // ----- Backbone: unit leaders to the command leader -----
+    PointToPointHelper backbone;
+    backbone.SetDeviceAttribute("DataRate", StringValue("5Mbps"));
+    backbone.SetChannelAttribute("Delay", StringValue(lookahead));
+
+    std::vector<NetDeviceContainer> backboneDevices(nUnits);
+    for (uint32_t u = 1; u < nUnits; ++u)
+    {
+        backboneDevices[u] = backbone.Install(units[0].leader, units[u].leader);
+    }
+
+    // ----- Internet -----
+    InternetStackHelper internet;
+    internet.Install(allNodes);
+
+    Ipv4AddressHelper ipv4;
+    std::vector<Ipv4InterfaceContainer> backboneIfaces(nUnits);
+    for (uint32_t u = 0; u < nUnits; ++u)
+    {
+        std::ostringstream wifiNet, backboneNet;
+        wifiNet << "10.5." << u << ".0";
+        ipv4.SetBase(Ipv4Address(wifiNet.str().c_str()), "255.255.255.0");
+        ipv4.Assign(unitDevices[u]);
+
+        if (u == 0)
+            continue;
+
+        backboneNet << "10.6." << u << ".0";
+        ipv4.SetBase(Ipv4Address(backboneNet.str().c_str()), "255.255.255.0");
+        backboneIfaces[u] = ipv4.Assign(backboneDevices[u]);
+    }
+
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    // ----- Traffic, installed on the owning rank only -----
+    UdpEchoServerHelper server(9);
+
+    UdpEchoClientHelper client(Ipv4Address::GetAny(), 9);
+    client.SetAttribute("PacketSize", UintegerValue(64));
+
+    for (uint32_t u = 0; u < nUnits; ++u)
+    {
+        if (u % systemCount != systemId)
+            continue;
+
+        Ptr<Node> leader = units[u].leader;
+        server.Install(leader).Start(Seconds(1.0));
+
+        // Heartbeats inside the unit
+        client.SetAttribute("RemoteAddress", AddressValue(
+            leader->GetObject<Ipv4>()->GetAddress(1, 0).GetLocal()));
+        client.SetAttribute("Interval", TimeValue(Seconds(2.0)));
+        for (uint32_t i = 0; i < units[u].followers.GetN(); ++i)
+            client.Install(units[u].followers.Get(i)).Start(Seconds(2.0));
+
+        // Status reports across the backbone
+        if (u == 0)
+            continue;
+
+        client.SetAttribute("RemoteAddress", AddressValue(backboneIfaces[u].GetAddress(0)));
+        client.SetAttribute("Interval", TimeValue(Seconds(1.0)));
+        ApplicationContainer report = client.Install(leader);
+        report.Start(Seconds(2.0));
+
+        Ptr<UdpEchoClient> app = DynamicCast<UdpEchoClient>(report.Get(0));
+        app->TraceConnectWithoutContext("Tx", MakeCallback(&ReportTx));
+        app->TraceConnectWithoutContext("Rx", MakeCallback(&ReportRx));
+    }
+
+    Simulator::Stop(Seconds(simTime));
+
+    FlowMonitorHelper flowHelper;
+    Ptr<FlowMonitor> flowMonitor = flowHelper.Install(localNodes);
+
+    auto wallStart = std::chrono::steady_clock::now();
+    Simulator::Run();
+    double wallRun = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - wallStart).count();
+
+    flowMonitor->CheckForLostPackets();
+
+    Ptr<Ipv4FlowClassifier> classifier =
+        DynamicCast<Ipv4FlowClassifier>(flowHelper.GetClassifier());
+
+    // Only unit-internal flows: both ends live on this rank. Backbone
+    // flows are counted by the report counters, since FlowMonitor
+    // cannot match a packet sent on one rank and received on another
+    Ipv4Mask backboneMask("255.255.0.0");
+    Ipv4Address backboneBase("10.6.0.0");
+
+    FlowMetrics local = ComputeFlowMetrics(
+        flowMonitor, classifier,
+        [&](const Ipv4FlowClassifier::FiveTuple &t) {
+            return !backboneMask.IsMatch(t.sourceAddress, backboneBase) &&
+                   !backboneMask.IsMatch(t.destinationAddress, backboneBase);
+        });
+
+    double totals[6] = {local.txPackets, local.rxPackets, local.delaySum,
+                        local.throughput, 0, 0};
+    double &totalTx = totals[0];
+    double &totalRx = totals[1];
+    double &totalDelay = totals[2];
+    double &totalThroughput = totals[3];
+    double &totalReportsSent = totals[4];
+    double &totalReportsAcked = totals[5];
+
+    totalReportsSent = reportsSent;
+    totalReportsAcked = reportsAcked;
+
+#ifdef NS3_MPI
+    if (MpiInterface::IsEnabled())
+    {
+        double sums[6];
+        double maxWall = 0;
+        MPI_Reduce(totals, sums, 6, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+        MPI_Reduce(&wallRun, &maxWall, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        std::copy(sums, sums + 6, totals);
+        wallRun = maxWall;
+    }
+#endif
+
+    if (systemId == 0)
+    {
+        double pdr = (totalTx > 0) ? (totalRx / totalTx) * 100.0 : 0.0;
+        double avgDelay = (totalRx > 0) ? (totalDelay / totalRx) : 0.0;
+        double reportRatio = (totalReportsSent > 0)
+                                 ? (totalReportsAcked / totalReportsSent) * 100.0
+                                 : 0.0;
+
+        std::cout << "\n===== DISTRIBUTED SWARM METRICS =====\n";
+        std::cout << "Units: " << nUnits << " (" << allNodes.GetN() << " nodes)\n";
+        std::cout << "Ranks: " << systemCount << "\n";
+        std::cout << "Tx Packets: " << totalTx << "\n";
+        std::cout << "Rx Packets: " << totalRx << "\n";
+        std::cout << "PDR: " << pdr << " %\n";
+        std::cout << "Avg Delay: " << avgDelay << " s\n";
+        std::cout << "Throughput: " << totalThroughput / 1000 << " kbps\n";
+        std::cout << "Backbone reports acked: " << reportRatio << " %\n";
+        std::cout << "Run wall time: " << wallRun << " s\n";
+        std::cout << "=====================================\n";
+    }
+
+    Simulator::Destroy();
+
+#ifdef NS3_MPI
+    if (MpiInterface::IsEnabled())
+        MpiInterface::Disable();
+#endif
+    return 0;
+}
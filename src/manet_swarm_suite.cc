@@ -0,0 +1,211 @@
+#include "ns3/core-module.h"
+
+#include "swarm_scenario.h"
+#include "swarm_fork.h"
+
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+using namespace ns3;
+
+/*
+ SWARM SUITE
+ - Runs the baseline, blackhole and grayhole patrol scenarios back-to-back
+   in one process (no per-variant process startup / module loading)
+ - Same per-scenario output as the stage 2/3 programs, then one
+   comparison table
+ - --scenarios picks a subset, e.g. --scenarios=baseline,grayhole
+ - --config=file.json runs a batch from a scenario file (no recompile):
+     { "simTime": 60,
+       "runs": [ { "preset": "baseline" },
+                 { "preset": "grayhole", "name": "gray_p05", "dropProbability": 0.5 } ] }
+   Top-level keys apply to every run, command-line options override
+   them, and each run entry overrides both. Without "runs", the file
+   only sets parameters for --scenarios
+ - --fork runs the patrol once up to attackTime and forks every run
+   from there (swarm_fork.h); runs may then differ only in name, attack,
+   maliciousNodeId and dropProbability. --jobs=N runs N forks at a time
+*/
+
+int main(int argc, char *argv[])
+{
+    std::string scenarios = "baseline,blackhole,grayhole";
+    std::string configFile;
+    bool forkRuns = false;
+    uint32_t jobs = 1;
+
+    SwarmScenarioConfig common;
+
+    CommandLine cmd;
+    cmd.AddValue("scenarios", "Comma-separated list: baseline, blackhole, grayhole", scenarios);
+    cmd.AddValue("config", "JSON scenario file (parameters and/or a runs list)", configFile);
+    cmd.AddValue("fork", "Share the pre-attack prefix and fork each run at attackTime", forkRuns);
+    cmd.AddValue("jobs", "Forked runs at a time (> 1 sends their output to <name>_swarm.log)", jobs);
+    common.AddCommandLineValues(cmd);
+    cmd.Parse(argc, argv);
+
+    // ----- Build the run list -----
+    std::vector<SwarmScenarioConfig> runs;
+
+    JsonValue file;
+    if (!configFile.empty())
+    {
+        file = JsonReader::ParseFile(configFile);
+
+        // File values first, then the command line again on top
+        common = SwarmScenarioConfig();
+        common.Apply(file);
+        cmd.Parse(argc, argv);
+    }
+
+    const JsonValue *entries = file.Find("runs");
+    if (entries)
+    {
+        NS_ABORT_MSG_IF(entries->type != JsonValue::ARRAY, "\"runs\" must be a list");
+        for (const JsonValue &entry : entries->items)
+        {
+            SwarmScenarioConfig config = common;
+            config.Apply(entry);
+            runs.push_back(config);
+        }
+    }
+    else
+    {
+        std::istringstream list(scenarios);
+        std::string name;
+        while (std::getline(list, name, ','))
+        {
+            SwarmScenarioConfig config = common;
+            config.ApplyPreset(name);
+            runs.push_back(config);
+        }
+    }
+
+    // ----- Run them back-to-back -----
+    std::vector<std::string> names;
+    std::vector<std::string> phys;
+    std::vector<FlowMetrics> results;
+    std::vector<double> recoveries;
+    std::vector<uint64_t> controls;
+    std::vector<double> energies;
+    std::vector<double> airtimes;
+    std::vector<uint64_t> rxErrors;
+    std::vector<uint64_t> leaderPackets;
+    std::vector<double> walls;
+
+    double prefixWall = -1.0;
+    if (forkRuns)
+    {
+        ForkedSweep sweep(runs);
+        sweep.SetJobs(jobs);
+        for (const ForkedRunResult &result : sweep.Run())
+        {
+            results.push_back(result.metrics);
+            recoveries.push_back(result.ok ? result.recoveryTime : -1.0);
+            controls.push_back(result.controlPackets);
+            energies.push_back(result.joulesPerBit);
+            airtimes.push_back(result.txAirtime);
+            rxErrors.push_back(result.rxErrors);
+            leaderPackets.push_back(result.leaderRxPackets);
+            walls.push_back(result.wallSeconds);
+        }
+        prefixWall = sweep.GetPrefixWallSeconds();
+    }
+    else
+    {
+        for (const SwarmScenarioConfig &config : runs)
+        {
+            auto wallStart = std::chrono::steady_clock::now();
+            SwarmScenario scenario(config);
+            results.push_back(scenario.Run());
+            recoveries.push_back(scenario.GetRecoveryTime());
+            controls.push_back(scenario.GetControlPackets());
+            energies.push_back(scenario.GetJoulesPerBit());
+            airtimes.push_back(scenario.GetTxAirtime());
+            rxErrors.push_back(scenario.GetRxErrors());
+            leaderPackets.push_back(scenario.GetLeaderRxPackets());
+            walls.push_back(std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - wallStart).count());
+        }
+    }
+
+    for (const SwarmScenarioConfig &config : runs)
+    {
+        names.push_back(config.name);
+        phys.push_back(config.wifiStandard + " " + config.rateControl + " " +
+                       std::to_string(config.payloadSize) + "B");
+    }
+
+    std::cout << "\n===== SWARM SUITE SUMMARY =====\n";
+    std::cout << std::left << std::setw(16) << "Scenario"
+              << std::setw(24) << "PHY"
+              << std::right << std::setw(10) << "PDR (%)"
+              << std::setw(14) << "Delay (s)"
+              << std::setw(18) << "Thr (kbps)"
+              << std::setw(12) << "Ctrl pkts"
+              << std::setw(14) << "Recovery (s)"
+              << std::setw(10) << "uJ/bit"
+              << std::setw(13) << "Airtime (s)"
+              << std::setw(10) << "Rx err"
+              << std::setw(13) << "Leader pkts"
+              << std::setw(12) << "Wall (s)" << "\n";
+
+    for (uint32_t i = 0; i < results.size(); ++i)
+    {
+        // 0 = never degraded
+        std::ostringstream recovery;
+        if (recoveries[i] < 0)
+            recovery << "never";
+        else
+            recovery << recoveries[i];
+
+        // Not counted without routingStats
+        std::ostringstream control;
+        if (runs[i].routingStats)
+            control << controls[i];
+        else
+            control << "-";
+
+        // Channel load only with channelStats
+        std::ostringstream airtime, errors, leader;
+        if (runs[i].channelStats)
+        {
+            airtime << airtimes[i];
+            errors << rxErrors[i];
+            leader << leaderPackets[i];
+        }
+        else
+        {
+            airtime << "-";
+            errors << "-";
+            leader << "-";
+        }
+
+        // 0 = energy accounting off
+        std::ostringstream energy;
+        if (energies[i] > 0)
+            energy << energies[i] * 1e6;
+        else
+            energy << "-";
+
+        std::cout << std::left << std::setw(16) << names[i]
+                  << std::setw(24) << phys[i]
+                  << std::right << std::setw(10) << results[i].Pdr()
+                  << std::setw(14) << results[i].AvgDelay()
+                  << std::setw(18) << results[i].ThroughputKbps()
+                  << std::setw(12) << control.str()
+                  << std::setw(14) << recovery.str()
+                  << std::setw(10) << energy.str()
+                  << std::setw(13) << airtime.str()
+                  << std::setw(10) << errors.str()
+                  << std::setw(13) << leader.str()
+                  << std::setw(12) << walls[i] << "\n";
+    }
+    if (prefixWall >= 0)
+        std::cout << "Shared prefix (0-" << runs[0].attackTime << " s): " << prefixWall
+                  << " s wall, run once for all " << runs.size() << " runs\n";
+    std::cout << "===============================\n";
+
+    return 0;
+}
@@ -0,0 +1,523 @@
+#ifndef MISSION_TRAFFIC_H
+#define MISSION_TRAFFIC_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+
+namespace ns3
+{
+
+/*
+ Mission traffic classes
+ - telemetry  periodic status, follower -> leader
+ - sensor     bursts of large readings at random times, follower -> leader
+ - video      constant bitrate stream from a few followers to the leader
+ - c2         small commands at random times, leader -> each follower,
+              with the tightest deadline
+ - Every packet carries a MissionHeader (class, sequence, send time)
+   and leaves a socket with the class's DSCP in the IP TOS byte and an
+   explicit socket priority. ns-3 maps TOS to priority from the old TOS
+   bits, not the DSCP (all AF classes would land in AC_BK), so the
+   priority is what selects the 802.11e access category on a QoS MAC:
+   c2 -> VO, video -> VI, telemetry -> BE, sensor -> BK
+ - Sources stop one maximum deadline before the end of the run, so no
+   packet still in flight at the end is counted as a miss
+ - Per class: sent/received, deadline misses (late or lost), mean delay,
+   jitter (mean |delay difference| between consecutive packets of one
+   flow, RFC 3550 style without smoothing) and on-time goodput
+*/
+enum MissionClass
+{
+    MISSION_TELEMETRY,
+    MISSION_SENSOR,
+    MISSION_VIDEO,
+    MISSION_C2,
+    N_MISSION_CLASSES
+};
+
+struct MissionClassInfo
+{
+    const char *name;
+    uint8_t tos;        // DSCP << 2
+    uint8_t priority;   // socket priority, 802.1D user priority -> AC
+    double deadline;    // s
+};
+
+inline const MissionClassInfo &
+GetMissionClassInfo(uint32_t cls)
+{
+    static const MissionClassInfo info[N_MISSION_CLASSES] = {
+        {"telemetry", 0x48, 0, 1.0},    // AF21, AC_BE
+        {"sensor", 0x28, 1, 5.0},       // AF11, AC_BK
+        {"video", 0x88, 5, 0.15},       // AF41, AC_VI
+        {"c2", 0xb8, 6, 0.1}};          // EF, AC_VO
+    return info[cls];
+}
+
+// Longest deadline of any class: sources stop this long before the end
+inline double
+GetMaxMissionDeadline()
+{
+    double deadline = 0.0;
+    for (uint32_t c = 0; c < N_MISSION_CLASSES; ++c)
+        deadline = std::max(deadline, GetMissionClassInfo(c).deadline);
+    return deadline;
+}
+
+// ----- Wire header -----
+class MissionHeader : public Header
+{
+  public:
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override { return GetTypeId(); }
+
+    void SetClass(uint8_t cls) { m_class = cls; }
+    uint8_t GetClass() const { return m_class; }
+    void SetSeq(uint32_t seq) { m_seq = seq; }
+    uint32_t GetSeq() const { return m_seq; }
+    void SetTs(Time ts) { m_ts = ts.GetNanoSeconds(); }
+    Time GetTs() const { return NanoSeconds(m_ts); }
+
+    // class u8, reserved u8 x3, seq u32, send time ns u64
+    uint32_t GetSerializedSize() const override { return 16; }
+    void Serialize(Buffer::Iterator start) const override;
+    uint32_t Deserialize(Buffer::Iterator start) override;
+    void Print(std::ostream &os) const override;
+
+  private:
+    uint8_t m_class = 0;
+    uint32_t m_seq = 0;
+    int64_t m_ts = 0;
+};
+
+NS_OBJECT_ENSURE_REGISTERED(MissionHeader);
+
+inline TypeId
+MissionHeader::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::MissionHeader")
+                            .SetParent<Header>()
+                            .SetGroupName("Applications")
+                            .AddConstructor<MissionHeader>();
+    return tid;
+}
+
+inline void
+MissionHeader::Serialize(Buffer::Iterator start) const
+{
+    start.WriteU8(m_class);
+    start.WriteU8(0);
+    start.WriteU16(0);
+    start.WriteHtonU32(m_seq);
+    start.WriteHtonU64(static_cast<uint64_t>(m_ts));
+}
+
+inline uint32_t
+MissionHeader::Deserialize(Buffer::Iterator start)
+{
+    m_class = start.ReadU8();
+    start.Next(3);
+    m_seq = start.ReadNtohU32();
+    m_ts = static_cast<int64_t>(start.ReadNtohU64());
+    return GetSerializedSize();
+}
+
+inline void
+MissionHeader::Print(std::ostream &os) const
+{
+    os << "class=" << uint32_t(m_class) << " seq=" << m_seq << " ts=" << m_ts;
+}
+
+// ----- Per-class statistics shared by all sources and sinks -----
+class MissionTrafficStats
+{
+  public:
+    void RecordTx(uint32_t cls) { ++m_classes[cls].sent; }
+    // flow: source and destination address, for per-flow jitter
+    void RecordRx(uint32_t cls, uint64_t flow, uint32_t size, Time delay);
+
+    // duration: time the sources were active, for goodput
+    void PrintSummary(Time duration) const;
+
+  private:
+    struct ClassStats
+    {
+        uint64_t sent = 0;
+        uint64_t received = 0;
+        uint64_t late = 0;
+        uint64_t onTimeBytes = 0;
+        double delaySum = 0.0;
+        double jitterSum = 0.0;
+        uint64_t jitterSamples = 0;
+    };
+
+    ClassStats m_classes[N_MISSION_CLASSES];
+    std::unordered_map<uint64_t, double> m_lastDelay[N_MISSION_CLASSES];   // flow -> delay
+};
+
+inline void
+MissionTrafficStats::RecordRx(uint32_t cls, uint64_t flow, uint32_t size, Time delay)
+{
+    ClassStats &s = m_classes[cls];
+    double d = delay.GetSeconds();
+
+    ++s.received;
+    s.delaySum += d;
+    if (d > GetMissionClassInfo(cls).deadline)
+        ++s.late;
+    else
+        s.onTimeBytes += size;
+
+    auto last = m_lastDelay[cls].emplace(flow, d);
+    if (!last.second)
+    {
+        s.jitterSum += std::fabs(d - last.first->second);
+        ++s.jitterSamples;
+        last.first->second = d;
+    }
+}
+
+inline void
+MissionTrafficStats::PrintSummary(Time duration) const
+{
+    double seconds = duration.GetSeconds();
+
+    std::cout << "\n===== MISSION TRAFFIC =====\n";
+    std::cout << std::left << std::setw(11) << "Class"
+              << std::right << std::setw(8) << "Sent"
+              << std::setw(8) << "Rcvd"
+              << std::setw(11) << "Miss (%)"
+              << std::setw(12) << "Delay (s)"
+              << std::setw(12) << "Jitter (s)"
+              << std::setw(14) << "Goodput (kbps)" << "\n";
+
+    for (uint32_t c = 0; c < N_MISSION_CLASSES; ++c)
+    {
+        const ClassStats &s = m_classes[c];
+        // Late and lost packets both miss the deadline
+        uint64_t onTime = s.received - s.late;
+        double miss = s.sent ? 100.0 * (s.sent - std::min(onTime, s.sent)) / s.sent : 0.0;
+
+        std::cout << std::left << std::setw(11) << GetMissionClassInfo(c).name
+                  << std::right << std::setw(8) << s.sent
+                  << std::setw(8) << s.received
+                  << std::setw(11) << miss
+                  << std::setw(12) << (s.received ? s.delaySum / s.received : 0.0)
+                  << std::setw(12) << (s.jitterSamples ? s.jitterSum / s.jitterSamples : 0.0)
+                  << std::setw(14) << (seconds > 0 ? s.onTimeBytes * 8.0 / seconds / 1000.0 : 0.0)
+                  << "\n";
+    }
+    std::cout << "===========================\n";
+}
+
+// ----- Source -----
+class MissionTrafficSource : public Application
+{
+  public:
+    static TypeId GetTypeId();
+
+    void SetStats(MissionTrafficStats *stats) { m_stats = stats; }
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    void StartApplication() override;
+    void StopApplication() override;
+
+    void StartBurst();
+    void Send(uint32_t remaining);
+
+    uint8_t m_class = MISSION_TELEMETRY;
+    Address m_remote;
+    uint32_t m_packetSize = 128;
+    Ptr<RandomVariableStream> m_interval;
+    uint32_t m_burstSize = 1;
+    Time m_burstSpacing;
+
+    Ptr<Socket> m_socket;
+    EventId m_event;
+    uint32_t m_seq = 0;
+    MissionTrafficStats *m_stats = nullptr;
+};
+
+NS_OBJECT_ENSURE_REGISTERED(MissionTrafficSource);
+
+inline TypeId
+MissionTrafficSource::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MissionTrafficSource")
+            .SetParent<Application>()
+            .SetGroupName("Applications")
+            .AddConstructor<MissionTrafficSource>()
+            .AddAttribute("Class",
+                          "Mission traffic class (MissionClass)",
+                          UintegerValue(MISSION_TELEMETRY),
+                          MakeUintegerAccessor(&MissionTrafficSource::m_class),
+                          MakeUintegerChecker<uint8_t>(0, N_MISSION_CLASSES - 1))
+            .AddAttribute("Remote",
+                          "Destination address and port",
+                          AddressValue(),
+                          MakeAddressAccessor(&MissionTrafficSource::m_remote),
+                          MakeAddressChecker())
+            .AddAttribute("PacketSize",
+                          "Payload size including the mission header (bytes)",
+                          UintegerValue(128),
+                          MakeUintegerAccessor(&MissionTrafficSource::m_packetSize),
+                          MakeUintegerChecker<uint32_t>(16))
+            .AddAttribute("Interval",
+                          "Time between bursts (s)",
+                          StringValue("ns3::ConstantRandomVariable[Constant=1.0]"),
+                          MakePointerAccessor(&MissionTrafficSource::m_interval),
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("BurstSize",
+                          "Packets per burst",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&MissionTrafficSource::m_burstSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("BurstSpacing",
+                          "Gap between the packets of one burst",
+                          TimeValue(MilliSeconds(2)),
+                          MakeTimeAccessor(&MissionTrafficSource::m_burstSpacing),
+                          MakeTimeChecker());
+    return tid;
+}
+
+inline void
+MissionTrafficSource::DoDispose()
+{
+    m_socket = nullptr;
+    m_interval = nullptr;
+    Application::DoDispose();
+}
+
+inline void
+MissionTrafficSource::StartApplication()
+{
+    m_socket = Socket::CreateSocket(GetNode(), UdpSocketFactory::GetTypeId());
+    m_socket->SetIpTos(GetMissionClassInfo(m_class).tos);
+    m_socket->SetPriority(GetMissionClassInfo(m_class).priority);   // after SetIpTos
+    m_socket->Bind();
+    m_socket->Connect(m_remote);
+
+    m_event = Simulator::Schedule(Seconds(m_interval->GetValue()),
+                                  &MissionTrafficSource::StartBurst, this);
+}
+
+inline void
+MissionTrafficSource::StopApplication()
+{
+    m_event.Cancel();
+    if (m_socket)
+        m_socket->Close();
+}
+
+inline void
+MissionTrafficSource::StartBurst()
+{
+    Send(m_burstSize);
+}
+
+inline void
+MissionTrafficSource::Send(uint32_t remaining)
+{
+    MissionHeader header;
+    header.SetClass(m_class);
+    header.SetSeq(m_seq++);
+    header.SetTs(Simulator::Now());
+
+    Ptr<Packet> packet = Create<Packet>(m_packetSize - header.GetSerializedSize());
+    packet->AddHeader(header);
+    m_socket->Send(packet);
+    if (m_stats)
+        m_stats->RecordTx(m_class);
+
+    if (remaining > 1)
+        m_event = Simulator::Schedule(m_burstSpacing, &MissionTrafficSource::Send, this,
+                                      remaining - 1);
+    else
+        m_event = Simulator::Schedule(Seconds(m_interval->GetValue()),
+                                      &MissionTrafficSource::StartBurst, this);
+}
+
+// ----- Sink (any class) -----
+class MissionTrafficSink : public Application
+{
+  public:
+    static TypeId GetTypeId();
+
+    void SetStats(MissionTrafficStats *stats) { m_stats = stats; }
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    void StartApplication() override;
+    void StopApplication() override;
+    void Receive(Ptr<Socket> socket);
+
+    uint16_t m_port = 9;
+    Ptr<Socket> m_socket;
+    uint32_t m_address = 0;
+    MissionTrafficStats *m_stats = nullptr;
+};
+
+NS_OBJECT_ENSURE_REGISTERED(MissionTrafficSink);
+
+inline TypeId
+MissionTrafficSink::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MissionTrafficSink")
+            .SetParent<Application>()
+            .SetGroupName("Applications")
+            .AddConstructor<MissionTrafficSink>()
+            .AddAttribute("Port",
+                          "Port mission traffic arrives on",
+                          UintegerValue(9),
+                          MakeUintegerAccessor(&MissionTrafficSink::m_port),
+                          MakeUintegerChecker<uint16_t>());
+    return tid;
+}
+
+inline void
+MissionTrafficSink::DoDispose()
+{
+    m_socket = nullptr;
+    Application::DoDispose();
+}
+
+inline void
+MissionTrafficSink::StartApplication()
+{
+    m_socket = Socket::CreateSocket(GetNode(), UdpSocketFactory::GetTypeId());
+    m_socket->Bind(InetSocketAddress(Ipv4Address::GetAny(), m_port));
+    m_socket->SetRecvCallback(MakeCallback(&MissionTrafficSink::Receive, this));
+    m_address = GetNode()->GetObject<Ipv4>()->GetAddress(1, 0).GetLocal().Get();
+}
+
+inline void
+MissionTrafficSink::StopApplication()
+{
+    if (m_socket)
+    {
+        m_socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+        m_socket->Close();
+    }
+}
+
+inline void
+MissionTrafficSink::Receive(Ptr<Socket> socket)
+{
+    Address from;
+    Ptr<Packet> packet;
+    while ((packet = socket->RecvFrom(from)))
+    {
+        MissionHeader header;
+        uint32_t size = packet->GetSize();
+        if (!m_stats || size < header.GetSerializedSize())
+            continue;
+        packet->PeekHeader(header);
+        if (header.GetClass() >= N_MISSION_CLASSES)
+            continue;
+
+        uint64_t source = InetSocketAddress::ConvertFrom(from).GetIpv4().Get();
+        m_stats->RecordRx(header.GetClass(),
+                          (source << 32) | m_address,
+                          size,
+                          Simulator::Now() - header.GetTs());
+    }
+}
+
+// ----- Mission load for one swarm -----
+struct MissionTrafficProfile
+{
+    uint32_t telemetrySize = 128;      // bytes
+    double telemetryInterval = 1.0;    // s
+    uint32_t sensorSize = 1024;
+    uint32_t sensorBurst = 16;         // packets per upload
+    double sensorMeanInterval = 10.0;  // s between uploads, exponential
+    uint32_t videoSources = 1;         // first followers stream video
+    double videoRateKbps = 256.0;
+    uint32_t videoSize = 1000;
+    uint32_t c2Size = 64;
+    double c2MeanInterval = 2.0;       // s between commands per follower, exponential
+};
+
+// Sinks on every node (port 9); telemetry, sensor and video from the
+// followers to the leader, C2 from the leader to each follower. Sources
+// send from start to stop
+inline void
+InstallMissionTraffic(Ptr<Node> leader,
+                      const NodeContainer &followers,
+                      const MissionTrafficProfile &profile,
+                      MissionTrafficStats *stats,
+                      Time start,
+                      Time stop)
+{
+    const uint16_t port = 9;
+
+    auto addressOf = [](Ptr<Node> node) {
+        return node->GetObject<Ipv4>()->GetAddress(1, 0).GetLocal();
+    };
+    auto install = [&](Ptr<Node> from, Ptr<Node> to, MissionClass cls, uint32_t size,
+                       const std::string &interval, uint32_t burst) {
+        Ptr<MissionTrafficSource> app = CreateObject<MissionTrafficSource>();
+        app->SetAttribute("Class", UintegerValue(cls));
+        app->SetAttribute("Remote", AddressValue(InetSocketAddress(addressOf(to), port)));
+        app->SetAttribute("PacketSize", UintegerValue(size));
+        app->SetAttribute("Interval", StringValue(interval));
+        app->SetAttribute("BurstSize", UintegerValue(burst));
+        app->SetStats(stats);
+        from->AddApplication(app);
+        app->SetStartTime(start);
+        app->SetStopTime(stop);
+    };
+    auto constant = [](double v) {
+        std::ostringstream s;
+        s << "ns3::ConstantRandomVariable[Constant=" << v << "]";
+        return s.str();
+    };
+    auto exponential = [](double mean) {
+        std::ostringstream s;
+        s << "ns3::ExponentialRandomVariable[Mean=" << mean << "]";
+        return s.str();
+    };
+
+    NodeContainer all;
+    all.Add(leader);
+    all.Add(followers);
+    for (uint32_t i = 0; i < all.GetN(); ++i)
+    {
+        Ptr<MissionTrafficSink> sink = CreateObject<MissionTrafficSink>();
+        sink->SetStats(stats);
+        all.Get(i)->AddApplication(sink);
+        sink->SetStartTime(Seconds(0.0));
+    }
+
+    double videoInterval = profile.videoSize * 8.0 / (profile.videoRateKbps * 1000.0);
+    for (uint32_t i = 0; i < followers.GetN(); ++i)
+    {
+        Ptr<Node> f = followers.Get(i);
+        install(f, leader, MISSION_TELEMETRY, profile.telemetrySize,
+                constant(profile.telemetryInterval), 1);
+        install(f, leader, MISSION_SENSOR, profile.sensorSize,
+                exponential(profile.sensorMeanInterval), profile.sensorBurst);
+        if (i < profile.videoSources)
+            install(f, leader, MISSION_VIDEO, profile.videoSize, constant(videoInterval), 1);
+        install(leader, f, MISSION_C2, profile.c2Size, exponential(profile.c2MeanInterval), 1);
+    }
+}
+
+} // namespace ns3
+
+#endif /* MISSION_TRAFFIC_H */
@@ -0,0 +1,258 @@
+"""
+Parallel results pipeline for sweeps and replications.
+
+Collects the per-flow outputs of many runs, computes PDR, delay and
+throughput for each one exactly like the C++ metrics block
+(ComputeFlowMetrics in manet_metrics.h, flow_metrics in
+flow_stats_reader.py), and aggregates runs of the same scenario into
+mean and 95% confidence interval (run_replications.summarize).
+
+Inputs are files or directories (searched recursively):
+  <name>_swarm_flows.csv   streamed per-flow CSV (flow_stats_stream.h)
+  <name>_swarm.xml         FlowMonitor XML (any *.xml if named directly),
+                           read with iterparse so only one <Flow>
+                           element is in memory at a time
+A run directory holding both keeps the CSV. Runs are grouped by scenario
+name, so the run_NNNN directories of run_replications.py --workdir become
+replications of one scenario. Files are parsed in a process pool.
+
+Usage:
+    python3 results_pipeline.py reps/ --csv runs.csv
+    python3 results_pipeline.py sweep_a/ sweep_b/ baseline_swarm.xml --jobs 8
+"""
+
+import argparse
+import csv
+import os
+import re
+import sys
+import time
+import xml.etree.ElementTree as ET
+from concurrent.futures import ProcessPoolExecutor
+
+from flow_stats_reader import flow_metrics
+from run_replications import summarize
+
+CSV_SUFFIX = "_swarm_flows.csv"
+XML_SUFFIX = "_swarm.xml"
+
+METRICS = ("pdr", "delay", "throughput")
+METRIC_UNITS = {"pdr": "%", "delay": "s", "throughput": "kbps"}
+
+# FlowMonitor writes times as e.g. "+1.5e+09ns"
+TIME_UNITS = {"s": 1.0, "ms": 1e-3, "us": 1e-6, "ns": 1e-9, "ps": 1e-12, "fs": 1e-15}
+TIME_RE = re.compile(r"^([-+]?[0-9.eE+-]*?)(s|ms|us|ns|ps|fs)$")
+
+
+def parse_time(text):
+    """
+    FlowMonitor time attribute to seconds.
+    """
+    match = TIME_RE.match(text)
+    if not match:
+        return float(text)
+    return float(match.group(1)) * TIME_UNITS[match.group(2)]
+
+
+def read_csv(path):
+    """
+    Per-flow totals from a finished CSV stream. Same result as
+    accumulate(iter_records(path)), without a dict per row.
+    """
+    flows = {}
+    with open(path, newline="") as f:
+        rows = csv.reader(line for line in f if not line.startswith("#"))
+        header = next(rows, None)
+        if header is None:
+            return flows
+        col = {name: i for i, name in enumerate(header)}
+        i_flow = col["flow"]
+        i_first = col["timeFirstTxPacket"]
+        i_last = col["timeLastRxPacket"]
+        ints = [(k, col[k]) for k in ("txPackets", "rxPackets", "txBytes", "rxBytes",
+                                      "lostPackets")]
+        floats = [(k, col[k]) for k in ("delaySum", "jitterSum")]
+
+        for row in rows:
+            flow = flows.get(row[i_flow])
+            if flow is None:
+                flow = flows[row[i_flow]] = dict.fromkeys(
+                    ("txPackets", "rxPackets", "txBytes", "rxBytes", "lostPackets"), 0)
+                flow.update(delaySum=0.0, jitterSum=0.0,
+                            timeFirstTxPacket=float(row[i_first]))
+            for key, i in ints:
+                flow[key] += int(row[i])
+            for key, i in floats:
+                flow[key] += float(row[i])
+            flow["timeLastRxPacket"] = row[i_last]
+
+    for flow in flows.values():
+        flow["timeLastRxPacket"] = float(flow["timeLastRxPacket"])
+    return flows
+
+
+def read_xml(path):
+    """
+    Per-flow totals from a FlowMonitor XML file, in the same shape
+    flow_stats_reader.accumulate() returns for a CSV stream.
+    """
+    flows = {}
+    in_stats = False
+
+    for event, elem in ET.iterparse(path, events=("start", "end")):
+        if elem.tag == "FlowStats":
+            in_stats = event == "start"
+            continue
+        if event != "end" or elem.tag != "Flow":
+            continue
+
+        if in_stats:
+            a = elem.attrib
+            flows[int(a["flowId"])] = {
+                "txPackets": int(a["txPackets"]),
+                "rxPackets": int(a["rxPackets"]),
+                "txBytes": int(a["txBytes"]),
+                "rxBytes": int(a["rxBytes"]),
+                "lostPackets": int(a["lostPackets"]),
+                "delaySum": parse_time(a["delaySum"]),
+                "jitterSum": parse_time(a["jitterSum"]),
+                "timeFirstTxPacket": parse_time(a["timeFirstTxPacket"]),
+                "timeLastRxPacket": parse_time(a["timeLastRxPacket"]),
+            }
+        # Histograms and probe entries go with the element
+        elem.clear()
+
+    return flows
+
+
+def scenario_name(path, named=False):
+    """
+    Scenario name from an output file name, or None if the file is not
+    a run output. A file named on the command line may be any XML file.
+    """
+    base = os.path.basename(path)
+    for suffix in (CSV_SUFFIX, XML_SUFFIX) + ((".xml",) if named else ()):
+        if base.endswith(suffix):
+            return base[:-len(suffix)]
+    return None
+
+
+def find_outputs(paths):
+    """
+    (scenario, path) for every run output below the given paths, one per
+    run: the CSV wins over the XML of the same run.
+    """
+    candidates = []
+    for path in paths:
+        if os.path.isdir(path):
+            for root, _, files in os.walk(path):
+                candidates.extend((os.path.join(root, f), False) for f in files)
+        else:
+            candidates.append((path, True))
+
+    runs = {}
+    for path, named in sorted(candidates):
+        name = scenario_name(path, named)
+        if name is None:
+            continue
+        key = (os.path.dirname(os.path.abspath(path)), name)
+        if key not in runs or path.endswith(CSV_SUFFIX):
+            runs[key] = path
+
+    return [(name, path) for (_, name), path in sorted(runs.items())]
+
+
+def analyze(item):
+    """
+    Metrics of one run (worker process).
+    """
+    name, path = item
+    if path.endswith(".csv"):
+        flows = read_csv(path)
+    else:
+        flows = read_xml(path)
+
+    pdr, delay, throughput = flow_metrics(flows)
+    return {"scenario": name, "path": path, "flows": len(flows),
+            "pdr": pdr, "delay": delay, "throughput": throughput}
+
+
+def aggregate(results):
+    """
+    Per scenario (in first-seen order): run count and summarize() of
+    each metric.
+    """
+    groups = {}
+    for r in results:
+        groups.setdefault(r["scenario"], []).append(r)
+
+    return {name: {m: summarize([r[m] for r in runs]) for m in METRICS}
+            for name, runs in groups.items()}
+
+
+def run_pipeline(paths, jobs=None):
+    """
+    Analyze every run output below paths in parallel. Returns the
+    per-run results in input order.
+    """
+    items = find_outputs(paths)
+    if not items:
+        return []
+
+    jobs = jobs or os.cpu_count()
+    if jobs == 1 or len(items) == 1:
+        return [analyze(item) for item in items]
+
+    chunk = max(1, len(items) // (jobs * 4))
+    with ProcessPoolExecutor(max_workers=jobs) as pool:
+        return list(pool.map(analyze, items, chunksize=chunk))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("paths", nargs="+", help="run output files or directories")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count(), help="parser processes")
+    parser.add_argument("--csv", help="write per-run metrics to this CSV file")
+    parser.add_argument("--summary-csv", help="write per-scenario mean/CI to this CSV file")
+    opts = parser.parse_args()
+
+    start = time.time()
+    results = run_pipeline(opts.paths, opts.jobs)
+    elapsed = time.time() - start
+
+    if not results:
+        sys.exit("No *_swarm_flows.csv or FlowMonitor XML files found")
+
+    summary = aggregate(results)
+
+    if opts.csv:
+        with open(opts.csv, "w", newline="") as f:
+            writer = csv.DictWriter(f, fieldnames=["scenario", "path", "flows"] + list(METRICS))
+            writer.writeheader()
+            writer.writerows(results)
+
+    if opts.summary_csv:
+        with open(opts.summary_csv, "w", newline="") as f:
+            writer = csv.writer(f)
+            writer.writerow(["scenario", "n"] +
+                            ["%s_%s" % (m, k) for m in METRICS for k in ("mean", "ci95")])
+            for name, s in summary.items():
+                writer.writerow([name, s["pdr"]["n"]] +
+                                [s[m][k] for m in METRICS for k in ("mean", "ci95")])
+
+    n_xml = sum(1 for r in results if not r["path"].endswith(".csv"))
+    print("\n===== RESULTS PIPELINE =====")
+    print("Runs: %d (%d CSV, %d XML) in %.2f s on %d workers"
+          % (len(results), len(results) - n_xml, n_xml, elapsed, opts.jobs))
+    print("%-20s %5s  %-24s %-26s %-24s" % ("Scenario", "n", "PDR (%)", "Delay (s)",
+                                           "Thr (kbps)"))
+    for name, s in summary.items():
+        cells = ["%.4g +/- %.3g" % (s[m]["mean"], s[m]["ci95"]) for m in METRICS]
+        print("%-20s %5d  %-24s %-26s %-24s" % (name, s["pdr"]["n"], *cells))
+    print("============================")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,161 @@
+#ifndef ROUTE_MITIGATION_H
+#define ROUTE_MITIGATION_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+
+#include "watchdog_detector.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace ns3
+{
+
+/*
+ Per-node frame blacklist
+ - Sits between the Wi-Fi PHY and the MAC's frame exchange manager as
+   the PHY's receive-ok callback, so it sees every decoded PSDU with its
+   802.11 headers and drops those whose transmitter address (address 2)
+   is blacklisted before the MAC acknowledges or forwards them up
+ - ACK and CTS frames carry no transmitter address and always pass
+ - The PHY's post-reception error model cannot do this: it is handed the
+   MSDU without the MAC header
+*/
+class BlacklistFilter
+{
+  public:
+    // Take over the PHY's receive-ok callback, forwarding to the MAC
+    void Install(Ptr<WifiNetDevice> dev);
+
+    void Add(Mac48Address mac)
+    {
+        if (std::find(m_blacklist.begin(), m_blacklist.end(), mac) == m_blacklist.end())
+            m_blacklist.push_back(mac);
+    }
+    uint64_t GetDropped() const { return m_dropped; }
+
+  private:
+    void Receive(Ptr<const WifiPsdu> psdu, RxSignalInfo rxSignalInfo, WifiTxVector txVector,
+                 std::vector<bool> perMpduStatus);
+
+    Ptr<FrameExchangeManager> m_fem;
+    std::vector<Mac48Address> m_blacklist;   // a handful of entries, linear scan
+    uint64_t m_dropped = 0;
+};
+
+inline void
+BlacklistFilter::Install(Ptr<WifiNetDevice> dev)
+{
+    m_fem = dev->GetMac()->GetFrameExchangeManager();
+    dev->GetPhy()->SetReceiveOkCallback(MakeCallback(&BlacklistFilter::Receive, this));
+}
+
+inline void
+BlacklistFilter::Receive(Ptr<const WifiPsdu> psdu, RxSignalInfo rxSignalInfo,
+                         WifiTxVector txVector, std::vector<bool> perMpduStatus)
+{
+    if (!m_blacklist.empty())
+    {
+        const WifiMacHeader &header = psdu->GetHeader(0);
+        if (!header.IsAck() && !header.IsCts() &&
+            std::find(m_blacklist.begin(), m_blacklist.end(), psdu->GetAddr2()) !=
+                m_blacklist.end())
+        {
+            m_dropped += psdu->GetNMpdus();
+            return;
+        }
+    }
+    m_fem->Receive(psdu, rxSignalInfo, txVector, perMpduStatus);
+}
+
+/*
+ Detector-driven route exclusion
+ - When a node's watchdog flags a neighbor, that node stops hearing the
+   neighbor at all (BlacklistFilter). AODV then loses the
+   neighbor's HELLOs, declares the link broken, sends a RERR and
+   rediscovers; the flagged node's RREQ/RREP relays are not heard
+   either, so the new route goes around it
+ - Only the node that flagged a neighbor reacts (no alarm flooding)
+*/
+class RouteMitigation
+{
+  public:
+    // Put a blacklist on every node's PHY and follow the detector's flags
+    void Install(const NodeContainer &nodes, WatchdogDetector &detector);
+
+    void PrintSummary(Time activation) const;
+
+  private:
+    void Flagged(uint32_t detector, uint32_t accused);
+
+    std::vector<BlacklistFilter> m_filters;
+    std::vector<Mac48Address> m_macs;
+    std::vector<bool> m_installed;
+
+    uint32_t m_blacklistings = 0;
+    Time m_first = Time::Max();
+};
+
+inline void
+RouteMitigation::Install(const NodeContainer &nodes, WatchdogDetector &detector)
+{
+    // Filters are registered by pointer: size the vector once
+    m_filters.resize(nodes.GetN());
+    m_macs.resize(nodes.GetN());
+    m_installed.assign(nodes.GetN(), false);
+
+    for (uint32_t i = 0; i < nodes.GetN(); ++i)
+    {
+        Ptr<Node> node = nodes.Get(i);
+        for (uint32_t d = 0; d < node->GetNDevices(); ++d)
+        {
+            Ptr<WifiNetDevice> dev = DynamicCast<WifiNetDevice>(node->GetDevice(d));
+            if (!dev)
+                continue;
+
+            m_macs[i] = Mac48Address::ConvertFrom(dev->GetAddress());
+            m_filters[i].Install(dev);
+            m_installed[i] = true;
+            break;
+        }
+    }
+
+    detector.SetFlagCallback(MakeCallback(&RouteMitigation::Flagged, this));
+}
+
+inline void
+RouteMitigation::Flagged(uint32_t detector, uint32_t accused)
+{
+    if (!m_installed[detector])
+        return;
+
+    m_filters[detector].Add(m_macs[accused]);
+    ++m_blacklistings;
+    m_first = Min(m_first, Simulator::Now());
+
+    std::cout << "[INFO] Node " << detector << " blacklisted node " << accused << " at "
+              << Simulator::Now().GetSeconds() << " s\n";
+}
+
+inline void
+RouteMitigation::PrintSummary(Time activation) const
+{
+    uint64_t dropped = 0;
+    for (const auto &filter : m_filters)
+        dropped += filter.GetDropped();
+
+    std::cout << "\n===== MITIGATION =====\n";
+    std::cout << "Blacklistings: " << m_blacklistings << "\n";
+    if (m_first != Time::Max())
+        std::cout << "First blacklisting: " << (m_first - activation).GetSeconds()
+                  << " s after attack\n";
+    std::cout << "Frames ignored from blacklisted nodes: " << dropped << "\n";
+    std::cout << "======================\n";
+}
+
+} // namespace ns3
+
+#endif /* ROUTE_MITIGATION_H */
@@ -0,0 +1,248 @@
+#ifndef ROUTING_INSTRUMENTATION_H
+#define ROUTING_INSTRUMENTATION_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+
+#include <iostream>
+#include <unordered_map>
+
+namespace ns3
+{
+
+/*
+ Routing control-plane cost
+ - Hooks Ipv4L3Protocol Tx/Rx on every node. A UDP packet on the
+   protocol's port (AODV 654, OLSR 698, DSDV 269) is control traffic;
+   every transmission counts, relays included, so bytes track airtime
+ - AODV messages are classified by their type byte (RREQ/RREP/RERR);
+   broadcast RREPs are HELLOs and counted apart
+ - Route discovery latency (AODV): from the first RREQ an originator
+   sends for a destination (hop count 0) to the RREP arriving back at
+   that originator. Retried RREQs do not restart the clock
+ - Headers are read with CopyData into a stack buffer, no allocation.
+   Only the IPv4 and UDP headers are copied for every packet; the
+   routing message is copied only for control traffic, and with no
+   routing protocol nothing is hooked at all
+*/
+class RoutingOverheadMonitor
+{
+  public:
+    explicit RoutingOverheadMonitor(const std::string &protocol);
+
+    // Connect to every node's Ipv4L3Protocol; call after the stack is installed
+    void Install();
+
+    void PrintSummary() const;
+
+    uint64_t GetControlPackets() const { return m_controlPackets; }
+    uint64_t GetControlBytes() const { return m_controlBytes; }
+    double GetMeanDiscoveryLatency() const
+    {
+        return m_discoveries ? m_discoveryDelaySum / m_discoveries : 0.0;
+    }
+
+  private:
+    enum AodvType
+    {
+        AODV_RREQ = 1,
+        AODV_RREP = 2,
+        AODV_RERR = 3
+    };
+
+    // Returns the routing payload offset, or 0 if this is not control traffic
+    uint32_t ControlOffset(const uint8_t *buf, uint32_t len) const;
+
+    void Tx(Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface);
+    void Rx(Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface);
+
+    static uint32_t ReadAddress(const uint8_t *p)
+    {
+        return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+    }
+    static uint64_t Key(uint32_t origin, uint32_t dst)
+    {
+        return (uint64_t(origin) << 32) | dst;
+    }
+
+    std::string m_protocol;
+    uint16_t m_port = 0;
+    bool m_aodv = false;
+
+    uint64_t m_allPackets = 0;
+    uint64_t m_allBytes = 0;
+    uint64_t m_controlPackets = 0;
+    uint64_t m_controlBytes = 0;
+    uint64_t m_rreq = 0;
+    uint64_t m_rrep = 0;
+    uint64_t m_hello = 0;
+    uint64_t m_rerr = 0;
+
+    std::unordered_map<uint64_t, Time> m_pending;   // (origin, dst) -> first RREQ
+    uint64_t m_discoveries = 0;
+    double m_discoveryDelaySum = 0.0;
+};
+
+inline
+RoutingOverheadMonitor::RoutingOverheadMonitor(const std::string &protocol)
+    : m_protocol(protocol),
+      m_aodv(protocol == "aodv")
+{
+    if (m_aodv)
+        m_port = 654;
+    else if (protocol == "olsr")
+        m_port = 698;
+    else if (protocol == "dsdv")
+        m_port = 269;
+}
+
+inline void
+RoutingOverheadMonitor::Install()
+{
+    if (m_port == 0)
+        return;
+
+    Config::ConnectWithoutContext("/NodeList/*/$ns3::Ipv4L3Protocol/Tx",
+                                  MakeCallback(&RoutingOverheadMonitor::Tx, this));
+    Config::ConnectWithoutContext("/NodeList/*/$ns3::Ipv4L3Protocol/Rx",
+                                  MakeCallback(&RoutingOverheadMonitor::Rx, this));
+}
+
+inline uint32_t
+RoutingOverheadMonitor::ControlOffset(const uint8_t *buf, uint32_t len) const
+{
+    if (m_port == 0 || len < 20)
+        return 0;
+
+    uint32_t ihl = (buf[0] & 0x0f) * 4;
+    if (buf[9] != UdpL4Protocol::PROT_NUMBER || len < ihl + 8)
+        return 0;
+
+    const uint8_t *udp = buf + ihl;
+    uint16_t srcPort = (udp[0] << 8) | udp[1];
+    uint16_t dstPort = (udp[2] << 8) | udp[3];
+    if (srcPort != m_port && dstPort != m_port)
+        return 0;
+
+    return ihl + 8;
+}
+
+inline void
+RoutingOverheadMonitor::Tx(Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface)
+{
+    // Interface 0 is the loopback, nothing goes on the air
+    if (interface == 0)
+        return;
+
+    ++m_allPackets;
+    m_allBytes += packet->GetSize();
+
+    // IPv4 (no options) and UDP headers first; the rest only for control
+    uint8_t buf[64];
+    uint32_t len = packet->CopyData(buf, 28);
+    uint32_t offset = ControlOffset(buf, len);
+    if (offset == 0)
+        return;
+
+    ++m_controlPackets;
+    m_controlBytes += packet->GetSize();
+
+    if (!m_aodv)
+        return;
+    len = packet->CopyData(buf, sizeof(buf));
+    if (len <= offset)
+        return;
+
+    const uint8_t *msg = buf + offset;
+    switch (msg[0])
+    {
+    case AODV_RREQ:
+        ++m_rreq;
+        // type, flags, reserved, hop count, id(4), dst(4), dstSeq(4), origin(4)
+        if (len >= offset + 24 && msg[3] == 0)
+        {
+            uint32_t dst = ReadAddress(msg + 8);
+            uint32_t origin = ReadAddress(msg + 16);
+            if (origin == ipv4->GetAddress(interface, 0).GetLocal().Get())
+                m_pending.emplace(Key(origin, dst), Simulator::Now());
+        }
+        break;
+    case AODV_RREP:
+    {
+        Ipv4Address to(ReadAddress(buf + 16));
+        if (to.IsBroadcast() || to == ipv4->GetAddress(interface, 0).GetBroadcast())
+            ++m_hello;
+        else
+            ++m_rrep;
+        break;
+    }
+    case AODV_RERR:
+        ++m_rerr;
+        break;
+    }
+}
+
+inline void
+RoutingOverheadMonitor::Rx(Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface)
+{
+    if (!m_aodv || m_pending.empty())
+        return;
+
+    uint8_t buf[64];
+    uint32_t len = packet->CopyData(buf, sizeof(buf));
+    uint32_t offset = ControlOffset(buf, len);
+    if (offset == 0 || len < offset + 16)
+        return;
+
+    // type, flags, prefix, hop count, dst(4), dstSeq(4), origin(4)
+    const uint8_t *msg = buf + offset;
+    if (msg[0] != AODV_RREP)
+        return;
+
+    uint32_t dst = ReadAddress(msg + 4);
+    uint32_t origin = ReadAddress(msg + 12);
+    if (origin != ipv4->GetAddress(interface, 0).GetLocal().Get())
+        return;
+
+    auto it = m_pending.find(Key(origin, dst));
+    if (it == m_pending.end())
+        return;
+
+    ++m_discoveries;
+    m_discoveryDelaySum += (Simulator::Now() - it->second).GetSeconds();
+    m_pending.erase(it);
+}
+
+inline void
+RoutingOverheadMonitor::PrintSummary() const
+{
+    std::cout << "\n===== ROUTING OVERHEAD (" << m_protocol << ") =====\n";
+    if (m_port == 0)
+    {
+        std::cout << "No dynamic routing protocol\n";
+        std::cout << "=====================================\n";
+        return;
+    }
+
+    std::cout << "Control packets sent: " << m_controlPackets << "\n";
+    std::cout << "Control bytes sent: " << m_controlBytes << "\n";
+    std::cout << "Control share of IP bytes sent: "
+              << (m_allBytes ? 100.0 * m_controlBytes / m_allBytes : 0.0) << " %\n";
+
+    if (m_aodv)
+    {
+        std::cout << "RREQ sent: " << m_rreq << "\n";
+        std::cout << "RREP sent: " << m_rrep << "\n";
+        std::cout << "RERR sent: " << m_rerr << "\n";
+        std::cout << "HELLO sent: " << m_hello << "\n";
+        std::cout << "Route discoveries completed: " << m_discoveries
+                  << " (" << m_pending.size() << " unanswered)\n";
+        std::cout << "Avg discovery latency: " << GetMeanDiscoveryLatency() << " s\n";
+    }
+    std::cout << "=====================================\n";
+}
+
+} // namespace ns3
+
+#endif /* ROUTING_INSTRUMENTATION_H */
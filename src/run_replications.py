@@ -0,0 +1,190 @@
+"""
+Parallel Monte Carlo replication runner for the swarm scenarios.
+
+Runs N replications of one scenario binary, each with a different
+--RngRun value, as separate processes spread over all cores. Each
+replication runs in its own working directory so the FlowMonitor output
+files do not clobber each other. PDR, delay and throughput are parsed
+from the metrics block every scenario prints and aggregated into mean,
+variance and a 95% confidence interval.
+
+Usage:
+    python3 run_replications.py --program manet_swarm_stage2 --runs 200
+    python3 run_replications.py --binary ./build/scratch/ns3.40-manet_swarm_stage2-default
+"""
+
+import argparse
+import csv
+import glob
+import math
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+from concurrent.futures import ThreadPoolExecutor, as_completed
+
+# Both metric block layouts in use ("PDR:" in the swarm files,
+# "Packet Delivery Ratio (PDR):" in the standalone scenarios)
+NUMBER = r"([-+]?\d*\.?\d+(?:[eE][-+]?\d+)?)"
+METRIC_PATTERNS = {
+    "pdr": re.compile(r"PDR\)?:\s*" + NUMBER),
+    "delay": re.compile(r"(?:Avg Delay|Average End-to-End Delay):\s*" + NUMBER),
+    "throughput": re.compile(r"Throughput:\s*" + NUMBER),
+}
+METRIC_UNITS = {"pdr": "%", "delay": "s", "throughput": "kbps"}
+
+# Two-sided 95% Student-t critical values by degrees of freedom
+T_95 = {
+    1: 12.706, 2: 4.303, 3: 3.182, 4: 2.776, 5: 2.571, 6: 2.447,
+    7: 2.365, 8: 2.306, 9: 2.262, 10: 2.228, 11: 2.201, 12: 2.179,
+    13: 2.160, 14: 2.145, 15: 2.131, 16: 2.120, 17: 2.110, 18: 2.101,
+    19: 2.093, 20: 2.086, 21: 2.080, 22: 2.074, 23: 2.069, 24: 2.064,
+    25: 2.060, 26: 2.056, 27: 2.052, 28: 2.048, 29: 2.045, 30: 2.042,
+    40: 2.021, 60: 2.000, 120: 1.980,
+}
+
+
+def t_critical(df):
+    """
+    95% two-sided t quantile. Uses the nearest tabulated degrees of
+    freedom at or below df, and the normal value past 120.
+    """
+    if df <= 0:
+        return float("nan")
+    if df > 120:
+        return 1.960
+    return T_95[max(k for k in T_95 if k <= df)]
+
+
+def summarize(values):
+    """
+    Mean, sample variance and 95% CI half-width of a list of floats.
+    """
+    n = len(values)
+    if n == 0:
+        return {"n": 0, "mean": float("nan"), "var": float("nan"), "ci95": float("nan")}
+
+    mean = sum(values) / n
+    var = sum((v - mean) ** 2 for v in values) / (n - 1) if n > 1 else 0.0
+    ci = t_critical(n - 1) * math.sqrt(var / n) if n > 1 else float("nan")
+
+    return {"n": n, "mean": mean, "var": var, "ci95": ci}
+
+
+def parse_metrics(output):
+    """
+    Extract the scenario metrics from a run's stdout. Missing metrics
+    are returned as None.
+    """
+    metrics = {}
+    for name, pattern in METRIC_PATTERNS.items():
+        match = pattern.search(output)
+        metrics[name] = float(match.group(1)) if match else None
+    return metrics
+
+
+def find_binary(ns3_dir, program):
+    """
+    Locate a built scratch program, e.g. build/scratch/ns3.40-<program>-default.
+    Running the binary directly avoids the ./ns3 build check per replication.
+    """
+    pattern = os.path.join(ns3_dir, "build", "scratch", "ns3*-" + program + "-*")
+    matches = sorted(glob.glob(pattern))
+    if not matches:
+        sys.exit("Could not find a built '%s' under %s (run ./ns3 build first)"
+                 % (program, os.path.join(ns3_dir, "build", "scratch")))
+    return os.path.abspath(matches[-1])
+
+
+def run_one(binary, run, extra_args, workdir, timeout):
+    """
+    Run one replication in its own directory and return its metrics.
+    """
+    rundir = os.path.join(workdir, "run_%04d" % run)
+    os.makedirs(rundir, exist_ok=True)
+
+    cmd = [binary, "--RngRun=%d" % run] + extra_args
+    start = time.time()
+    proc = subprocess.run(cmd, cwd=rundir, capture_output=True,
+                          text=True, timeout=timeout)
+    wall = time.time() - start
+
+    if proc.returncode != 0:
+        raise RuntimeError("run %d exited with %d:\n%s"
+                           % (run, proc.returncode, proc.stderr[-2000:]))
+
+    result = parse_metrics(proc.stdout)
+    result["run"] = run
+    result["wall"] = wall
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--program", help="scratch program name, e.g. manet_swarm_stage2")
+    parser.add_argument("--binary", help="path to a built scenario binary (overrides --program)")
+    parser.add_argument("--ns3-dir", default=os.environ.get("NS3_DIR", "."),
+                        help="ns-3 source tree containing build/ (default: $NS3_DIR or .)")
+    parser.add_argument("--runs", type=int, default=30, help="number of replications")
+    parser.add_argument("--first-run", type=int, default=1, help="first RngRun value")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count(), help="parallel processes")
+    parser.add_argument("--timeout", type=float, default=None, help="per-run timeout (s)")
+    parser.add_argument("--workdir", help="keep per-run outputs here instead of a temp dir")
+    parser.add_argument("--csv", help="write per-run results to this CSV file")
+    parser.add_argument("args", nargs="*", help="extra arguments passed to every run")
+    opts = parser.parse_args()
+
+    if opts.binary:
+        binary = os.path.abspath(opts.binary)
+    elif opts.program:
+        binary = find_binary(opts.ns3_dir, opts.program)
+    else:
+        parser.error("one of --program or --binary is required")
+
+    workdir = opts.workdir or tempfile.mkdtemp(prefix="manet_reps_")
+    runs = range(opts.first_run, opts.first_run + opts.runs)
+
+    print("Running %d replications of %s on %d workers (outputs in %s)"
+          % (opts.runs, os.path.basename(binary), opts.jobs, workdir))
+
+    # Threads are enough here: each one just waits on its child process
+    results, failures = [], 0
+    start = time.time()
+    with ThreadPoolExecutor(max_workers=opts.jobs) as pool:
+        futures = [pool.submit(run_one, binary, r, opts.args, workdir, opts.timeout)
+                   for r in runs]
+        for future in as_completed(futures):
+            try:
+                results.append(future.result())
+            except (RuntimeError, subprocess.TimeoutExpired) as err:
+                failures += 1
+                print("[WARN] %s" % err, file=sys.stderr)
+    elapsed = time.time() - start
+
+    results.sort(key=lambda r: r["run"])
+
+    if opts.csv:
+        with open(opts.csv, "w", newline="") as f:
+            writer = csv.DictWriter(f, fieldnames=["run", "pdr", "delay", "throughput", "wall"])
+            writer.writeheader()
+            writer.writerows(results)
+
+    serial = sum(r["wall"] for r in results)
+    print("\n===== REPLICATION SUMMARY =====")
+    print("Completed: %d  Failed: %d" % (len(results), failures))
+    for name in METRIC_PATTERNS:
+        s = summarize([r[name] for r in results if r[name] is not None])
+        print("%-10s mean=%.6g var=%.6g 95%%CI=+/-%.6g %s (n=%d)"
+              % (name, s["mean"], s["var"], s["ci95"], METRIC_UNITS[name], s["n"]))
+    print("Wall time: %.1f s (sum of runs %.1f s, speedup %.1fx)"
+          % (elapsed, serial, serial / elapsed if elapsed > 0 else 0.0))
+    print("===============================")
+
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,51 @@
+#ifndef SCHEDULER_CONFIG_H
+#define SCHEDULER_CONFIG_H
+
+#include "ns3/core-module.h"
+
+#include <string>
+
+namespace ns3
+{
+
+/*
+ Event scheduler selection
+ - map       MapScheduler (std::map, ns-3's default)
+ - heap      HeapScheduler (binary heap in a vector)
+ - calendar  CalendarScheduler (bucketed by time, resized with the queue)
+ - list      ListScheduler (sorted linked list, O(n) insert)
+ - priority  PriorityQueueScheduler (std::priority_queue)
+ - The profiler wraps whichever is chosen (SimProfiler::Enable takes the
+   type name), so profiled runs compare schedulers too
+ - manet_scheduler_bench.cc measures them on the swarm's event mix
+*/
+inline std::string
+GetSchedulerTypeName(const std::string &scheduler)
+{
+    if (scheduler == "map")
+        return "ns3::MapScheduler";
+    if (scheduler == "heap")
+        return "ns3::HeapScheduler";
+    if (scheduler == "calendar")
+        return "ns3::CalendarScheduler";
+    if (scheduler == "list")
+        return "ns3::ListScheduler";
+    if (scheduler == "priority")
+        return "ns3::PriorityQueueScheduler";
+
+    NS_ABORT_MSG("Unknown scheduler " << scheduler << " (map, heap, calendar, list or priority)");
+    return "";
+}
+
+// Call before anything is scheduled; Simulator::Destroy() resets it
+inline void
+ConfigureScheduler(const std::string &scheduler)
+{
+    ObjectFactory factory;
+    factory.SetTypeId(GetSchedulerTypeName(scheduler));
+    Simulator::SetScheduler(factory);
+}
+
+} // namespace ns3
+
+#endif /* SCHEDULER_CONFIG_H */
@@ -0,0 +1,309 @@
+#ifndef SIM_PROFILER_H
+#define SIM_PROFILER_H
+
+#include "ns3/core-module.h"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cxxabi.h>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <typeindex>
+#include <unordered_map>
+
+namespace ns3
+{
+
+/*
+ Event-source profiling scheduler
+ - Wraps the real scheduler (InnerType, MapScheduler by default) and
+   classifies every event it hands to the simulator by the C++ type of
+   its EventImpl. MakeEvent's types carry the target member function,
+   e.g. MakeEvent<void (ns3::WifiPhy::*)()...>, so the demangled name
+   tells which model scheduled it
+ - Classification is cached per type; the per-event cost is one
+   typeid lookup in a small hash map and a counter increment
+ - Counts live in a process-wide table so the profiler can read them
+   after the simulator (and its scheduler) is gone
+*/
+class ProfilingScheduler : public Scheduler
+{
+  public:
+    enum Source
+    {
+        MOBILITY,
+        PHY,
+        MAC,
+        ROUTING,
+        APPLICATION,
+        OTHER,
+        CANCELLED,
+        N_SOURCES
+    };
+
+    static TypeId GetTypeId();
+    static const char *GetSourceName(uint32_t source);
+
+    // Process-wide counters, cleared at the start of each profiled run
+    static uint64_t *Counts()
+    {
+        static uint64_t counts[N_SOURCES];
+        return counts;
+    }
+    static void ResetCounts() { std::fill(Counts(), Counts() + N_SOURCES, 0); }
+
+    void Insert(const Event &ev) override { m_inner->Insert(ev); }
+    bool IsEmpty() const override { return m_inner->IsEmpty(); }
+    Event PeekNext() const override { return m_inner->PeekNext(); }
+    Event RemoveNext() override;
+    void Remove(const Event &ev) override { m_inner->Remove(ev); }
+
+  private:
+    void SetInnerType(std::string type);
+    std::string GetInnerType() const { return m_innerType; }
+
+    static Source Classify(const std::string &name);
+
+    std::string m_innerType;
+    Ptr<Scheduler> m_inner;
+    std::unordered_map<std::type_index, Source> m_sources;
+};
+
+NS_OBJECT_ENSURE_REGISTERED(ProfilingScheduler);
+
+inline TypeId
+ProfilingScheduler::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::ProfilingScheduler")
+            .SetParent<Scheduler>()
+            .SetGroupName("Core")
+            .AddConstructor<ProfilingScheduler>()
+            .AddAttribute("InnerType",
+                          "TypeId of the scheduler that actually orders events",
+                          StringValue("ns3::MapScheduler"),
+                          MakeStringAccessor(&ProfilingScheduler::SetInnerType,
+                                             &ProfilingScheduler::GetInnerType),
+                          MakeStringChecker());
+    return tid;
+}
+
+inline const char *
+ProfilingScheduler::GetSourceName(uint32_t source)
+{
+    static const char *names[N_SOURCES] = {
+        "mobility", "phy", "mac", "routing", "application", "other", "cancelled"};
+    return names[source];
+}
+
+inline void
+ProfilingScheduler::SetInnerType(std::string type)
+{
+    ObjectFactory factory;
+    factory.SetTypeId(type);
+    m_inner = factory.Create<Scheduler>();
+    m_innerType = type;
+}
+
+inline ProfilingScheduler::Source
+ProfilingScheduler::Classify(const std::string &name)
+{
+    auto has = [&name](const char *s) { return name.find(s) != std::string::npos; };
+
+    if (has("Mobility") || has("LeaderTrack") || has("SwarmFormation"))
+        return MOBILITY;
+    if (has("Phy") || has("SpectrumChannel") || has("WifiChannel") || has("Interference"))
+        return PHY;
+    if (has("Mac") || has("Txop") || has("ChannelAccess") || has("FrameExchange") ||
+        has("BlockAck") || has("WifiRemoteStation"))
+        return MAC;
+    if (has("aodv") || has("olsr") || has("dsdv") || has("Routing") || has("Ipv4") ||
+        has("Arp") || has("Attack"))
+        return ROUTING;
+    if (has("Application") || has("Client") || has("Server") || has("Socket") ||
+        has("Udp") || has("Tcp"))
+        return APPLICATION;
+    return OTHER;
+}
+
+inline Scheduler::Event
+ProfilingScheduler::RemoveNext()
+{
+    Event ev = m_inner->RemoveNext();
+
+    if (ev.impl->IsCancelled())
+    {
+        ++Counts()[CANCELLED];
+        return ev;
+    }
+
+    std::type_index type(typeid(*ev.impl));
+    auto it = m_sources.find(type);
+    if (it == m_sources.end())
+    {
+        int status = 0;
+        char *demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+        Source source = Classify(status == 0 ? demangled : type.name());
+        std::free(demangled);
+        it = m_sources.emplace(type, source).first;
+    }
+    ++Counts()[it->second];
+    return ev;
+}
+
+/*
+ Run profiler (opt-in)
+ - Enable() before the scenario schedules anything: installs the
+   ProfilingScheduler and starts the setup phase clock
+ - BeginPhase()/EndPhase() time named phases (setup, run, metrics, ...)
+ - Write() appends one JSON object per line, so a file collects a
+   history of runs that can be diffed or plotted for regressions
+*/
+class SimProfiler
+{
+  public:
+    void Enable(const std::string &innerScheduler = "ns3::MapScheduler");
+    bool IsEnabled() const { return m_enabled; }
+
+    void BeginPhase(const std::string &phase);
+    void EndPhase();
+
+    // Call after Simulator::Run(), before Simulator::Destroy()
+    void CaptureRun();
+
+    void SetLabel(const std::string &key, const std::string &value) { m_labels[key] = value; }
+    void SetLabel(const std::string &key, double value) { m_numbers[key] = value; }
+
+    void Print() const;
+    void Write(const std::string &path) const;
+
+    static double PeakRssKb();
+
+  private:
+    typedef std::chrono::steady_clock Clock;
+
+    bool m_enabled = false;
+    std::string m_phase;
+    Clock::time_point m_phaseStart;
+    std::map<std::string, double> m_phases;
+    std::map<std::string, std::string> m_labels;
+    std::map<std::string, double> m_numbers;
+
+    uint64_t m_events = 0;
+    uint64_t m_bySource[ProfilingScheduler::N_SOURCES] = {};
+};
+
+inline void
+SimProfiler::Enable(const std::string &innerScheduler)
+{
+    ObjectFactory factory;
+    factory.SetTypeId("ns3::ProfilingScheduler");
+    factory.Set("InnerType", StringValue(innerScheduler));
+    Simulator::SetScheduler(factory);
+
+    ProfilingScheduler::ResetCounts();
+    m_enabled = true;
+    BeginPhase("setup");
+}
+
+inline void
+SimProfiler::BeginPhase(const std::string &phase)
+{
+    if (!m_enabled)
+        return;
+    EndPhase();
+    m_phase = phase;
+    m_phaseStart = Clock::now();
+}
+
+inline void
+SimProfiler::EndPhase()
+{
+    if (!m_enabled || m_phase.empty())
+        return;
+    m_phases[m_phase] += std::chrono::duration<double>(Clock::now() - m_phaseStart).count();
+    m_phase.clear();
+}
+
+inline void
+SimProfiler::CaptureRun()
+{
+    if (!m_enabled)
+        return;
+    m_events = Simulator::GetEventCount();
+    std::copy(ProfilingScheduler::Counts(),
+              ProfilingScheduler::Counts() + ProfilingScheduler::N_SOURCES,
+              m_bySource);
+}
+
+inline double
+SimProfiler::PeakRssKb()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;   // kilobytes on Linux
+}
+
+inline void
+SimProfiler::Print() const
+{
+    if (!m_enabled)
+        return;
+
+    auto run = m_phases.find("run");
+    double wallRun = (run != m_phases.end()) ? run->second : 0.0;
+
+    std::cout << "\n===== PROFILE =====\n";
+    for (const auto &phase : m_phases)
+        std::cout << "Phase " << phase.first << ": " << phase.second << " s\n";
+    std::cout << "Events: " << m_events << "\n";
+    std::cout << "Events/s: " << (wallRun > 0 ? m_events / wallRun : 0.0) << "\n";
+    for (uint32_t i = 0; i < ProfilingScheduler::N_SOURCES; ++i)
+        std::cout << "  " << ProfilingScheduler::GetSourceName(i) << ": " << m_bySource[i] << "\n";
+    std::cout << "Peak RSS: " << PeakRssKb() / 1024.0 << " MB\n";
+    std::cout << "===================\n";
+}
+
+inline void
+SimProfiler::Write(const std::string &path) const
+{
+    if (!m_enabled || path.empty())
+        return;
+
+    std::ofstream out(path, std::ios::app);
+    NS_ABORT_MSG_IF(!out, "Cannot open " << path);
+
+    auto run = m_phases.find("run");
+    double wallRun = (run != m_phases.end()) ? run->second : 0.0;
+
+    out << "{";
+    for (const auto &label : m_labels)
+        out << "\"" << label.first << "\": \"" << label.second << "\", ";
+    for (const auto &number : m_numbers)
+        out << "\"" << number.first << "\": " << number.second << ", ";
+
+    out << "\"events\": " << m_events
+        << ", \"eventsPerSecond\": " << (wallRun > 0 ? m_events / wallRun : 0.0)
+        << ", \"peakRssKb\": " << PeakRssKb();
+
+    out << ", \"phases\": {";
+    const char *sep = "";
+    for (const auto &phase : m_phases)
+    {
+        out << sep << "\"" << phase.first << "\": " << phase.second;
+        sep = ", ";
+    }
+
+    out << "}, \"eventsBySource\": {";
+    for (uint32_t i = 0; i < ProfilingScheduler::N_SOURCES; ++i)
+        out << (i ? ", " : "") << "\"" << ProfilingScheduler::GetSourceName(i) << "\": " << m_bySource[i];
+    out << "}}\n";
+}
+
+} // namespace ns3
+
+#endif /* SIM_PROFILER_H */
@@ -0,0 +1,381 @@
+#ifndef SPATIAL_GRID_SPECTRUM_CHANNEL_H
+#define SPATIAL_GRID_SPECTRUM_CHANNEL_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/propagation-module.h"
+#include "ns3/spectrum-module.h"
+#include "ns3/wifi-module.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace ns3
+{
+
+/*
+ Spatial-grid spectrum channel
+ - Drop-in SpectrumChannel for SpectrumWifiPhy that only visits
+   receivers in the 3x3 grid cells around the transmitter, instead of
+   every PHY on the channel (O(N) per frame, O(N^2) per round)
+ - Cell size = reception range + drift slack. The range is where the
+   configured (deterministic, distance-monotone) loss model drops
+   MaxTxPower below CullThreshold; set Range to override it
+ - The grid is rebuilt lazily: on the first transmission after any
+   CourseChange, or after RefreshInterval for nodes that move without
+   notifications (constant velocity). MaxSpeed * RefreshInterval is the
+   drift allowance folded into the cell size
+ - Receivers beyond the range get no loss computation and no event.
+   Only frequency-flat PropagationLossModels are applied
+ - EnableCulling=false visits every PHY, for before/after counts
+*/
+class SpatialGridSpectrumChannel : public SpectrumChannel
+{
+  public:
+    static TypeId GetTypeId();
+
+    void AddRx(Ptr<SpectrumPhy> phy) override;
+    void RemoveRx(Ptr<SpectrumPhy> phy) override;
+    void StartTx(Ptr<SpectrumSignalParameters> params) override;
+
+    std::size_t GetNDevices() const override { return m_phys.size(); }
+    Ptr<NetDevice> GetDevice(std::size_t i) const override { return m_phys[i]->GetDevice(); }
+
+    // Counters for the culling report
+    uint64_t GetTransmissions() const { return m_transmissions; }
+    uint64_t GetCandidates() const { return m_candidates; }
+    uint64_t GetLossComputations() const { return m_lossComputations; }
+    uint64_t GetRxEvents() const { return m_rxEvents; }
+    uint64_t GetGridRebuilds() const { return m_rebuilds; }
+    double GetRange() const { return m_range; }
+
+  private:
+    typedef uint64_t CellKey;
+
+    CellKey KeyOf(int64_t cx, int64_t cy) const
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) |
+               static_cast<uint32_t>(cy);
+    }
+    int64_t CellOf(double coordinate) const
+    {
+        return static_cast<int64_t>(std::floor(coordinate / m_cellSize));
+    }
+
+    void ComputeRange();
+    void Rebuild();
+    void MarkDirty(Ptr<const MobilityModel>) { m_dirty = true; }
+    void Deliver(Ptr<SpectrumSignalParameters> txParams, Ptr<SpectrumPhy> rxPhy);
+    void StartRx(Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
+
+    std::vector<Ptr<SpectrumPhy>> m_phys;
+    std::unordered_map<CellKey, std::vector<Ptr<SpectrumPhy>>> m_grid;
+    std::unordered_set<const MobilityModel *> m_watched;
+
+    bool m_culling;
+    double m_rangeAttr;
+    double m_cullThreshold;
+    double m_maxTxPower;
+    double m_maxSpeed;
+    Time m_refresh;
+
+    double m_range = 0.0;
+    double m_cellSize = 0.0;
+    bool m_dirty = true;
+    Time m_lastRebuild;
+
+    uint64_t m_transmissions = 0;
+    uint64_t m_candidates = 0;
+    uint64_t m_lossComputations = 0;
+    uint64_t m_rxEvents = 0;
+    uint64_t m_rebuilds = 0;
+};
+
+NS_OBJECT_ENSURE_REGISTERED(SpatialGridSpectrumChannel);
+
+inline TypeId
+SpatialGridSpectrumChannel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::SpatialGridSpectrumChannel")
+            .SetParent<SpectrumChannel>()
+            .SetGroupName("Spectrum")
+            .AddConstructor<SpatialGridSpectrumChannel>()
+            .AddAttribute("EnableCulling",
+                          "Visit only receivers in neighboring grid cells",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&SpatialGridSpectrumChannel::m_culling),
+                          MakeBooleanChecker())
+            .AddAttribute("Range",
+                          "Reception range in m (0 = derive from the loss model)",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&SpatialGridSpectrumChannel::m_rangeAttr),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("CullThreshold",
+                          "Received power (dBm) below which a signal is ignored, "
+                          "kept under RxSensitivity so interference is preserved",
+                          DoubleValue(-110.0),
+                          MakeDoubleAccessor(&SpatialGridSpectrumChannel::m_cullThreshold),
+                          MakeDoubleChecker<double>())
+            .AddAttribute("MaxTxPower",
+                          "Highest transmit power (dBm) used to derive the range",
+                          DoubleValue(20.0),
+                          MakeDoubleAccessor(&SpatialGridSpectrumChannel::m_maxTxPower),
+                          MakeDoubleChecker<double>())
+            .AddAttribute("MaxSpeed",
+                          "Fastest node speed (m/s), bounds drift between rebuilds",
+                          DoubleValue(20.0),
+                          MakeDoubleAccessor(&SpatialGridSpectrumChannel::m_maxSpeed),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("RefreshInterval",
+                          "Maximum age of the grid before it is rebuilt",
+                          TimeValue(Seconds(1.0)),
+                          MakeTimeAccessor(&SpatialGridSpectrumChannel::m_refresh),
+                          MakeTimeChecker());
+    return tid;
+}
+
+inline void
+SpatialGridSpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
+{
+    m_phys.push_back(phy);
+    m_dirty = true;
+}
+
+inline void
+SpatialGridSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
+{
+    m_phys.erase(std::remove(m_phys.begin(), m_phys.end(), phy), m_phys.end());
+    m_dirty = true;
+}
+
+inline void
+SpatialGridSpectrumChannel::ComputeRange()
+{
+    m_range = m_rangeAttr;
+
+    if (m_range <= 0.0)
+    {
+        NS_ABORT_MSG_IF(!m_propagationLoss, "Grid channel needs a propagation loss model");
+
+        Ptr<ConstantPositionMobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+        Ptr<ConstantPositionMobilityModel> b = CreateObject<ConstantPositionMobilityModel>();
+
+        // Bisect the distance where the signal falls below the threshold
+        double lo = 1.0;
+        double hi = 1.0e5;
+        for (int i = 0; i < 60; ++i)
+        {
+            double mid = 0.5 * (lo + hi);
+            b->SetPosition(Vector(mid, 0.0, 0.0));
+            if (m_propagationLoss->CalcRxPower(m_maxTxPower, a, b) >= m_cullThreshold)
+                lo = mid;
+            else
+                hi = mid;
+        }
+        m_range = hi;
+    }
+
+    m_cellSize = m_range + m_maxSpeed * m_refresh.GetSeconds();
+}
+
+inline void
+SpatialGridSpectrumChannel::Rebuild()
+{
+    if (m_cellSize <= 0.0)
+        ComputeRange();
+
+    for (auto &cell : m_grid)
+        cell.second.clear();
+
+    for (const auto &phy : m_phys)
+    {
+        Ptr<MobilityModel> mob = phy->GetMobility();
+        if (!mob)
+            continue;
+
+        // Re-bin immediately when a node jumps (e.g. formation switch)
+        if (m_watched.insert(PeekPointer(mob)).second)
+        {
+            mob->TraceConnectWithoutContext(
+                "CourseChange", MakeCallback(&SpatialGridSpectrumChannel::MarkDirty, this));
+        }
+
+        Vector p = mob->GetPosition();
+        m_grid[KeyOf(CellOf(p.x), CellOf(p.y))].push_back(phy);
+    }
+
+    m_dirty = false;
+    m_lastRebuild = Simulator::Now();
+    ++m_rebuilds;
+}
+
+inline void
+SpatialGridSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
+{
+    ++m_transmissions;
+
+    if (!m_culling)
+    {
+        for (const auto &phy : m_phys)
+            Deliver(txParams, phy);
+        return;
+    }
+
+    if (m_dirty || Simulator::Now() - m_lastRebuild >= m_refresh)
+        Rebuild();
+
+    Ptr<MobilityModel> senderMobility = txParams->txPhy->GetMobility();
+    Vector s = senderMobility->GetPosition();
+    int64_t cx = CellOf(s.x);
+    int64_t cy = CellOf(s.y);
+
+    for (int64_t dx = -1; dx <= 1; ++dx)
+    {
+        for (int64_t dy = -1; dy <= 1; ++dy)
+        {
+            auto cell = m_grid.find(KeyOf(cx + dx, cy + dy));
+            if (cell == m_grid.end())
+                continue;
+
+            for (const auto &phy : cell->second)
+                Deliver(txParams, phy);
+        }
+    }
+}
+
+inline void
+SpatialGridSpectrumChannel::Deliver(Ptr<SpectrumSignalParameters> txParams,
+                                    Ptr<SpectrumPhy> rxPhy)
+{
+    if (rxPhy == txParams->txPhy)
+        return;
+
+    Ptr<NetDevice> rxDevice = rxPhy->GetDevice();
+    Ptr<NetDevice> txDevice = txParams->txPhy->GetDevice();
+    if (rxDevice && txDevice && rxDevice->GetNode() == txDevice->GetNode())
+        return;
+
+    ++m_candidates;
+
+    Ptr<MobilityModel> senderMobility = txParams->txPhy->GetMobility();
+    Ptr<MobilityModel> receiverMobility = rxPhy->GetMobility();
+    Ptr<SpectrumSignalParameters> rxParams = nullptr;
+    Time delay = Seconds(0);
+
+    if (senderMobility && receiverMobility)
+    {
+        // Exact range check before any loss computation
+        if (m_culling &&
+            senderMobility->GetDistanceFrom(receiverMobility) > m_range)
+            return;
+
+        double pathLossDb = 0.0;
+        if (txParams->txAntenna)
+        {
+            Angles txAngles(receiverMobility->GetPosition(), senderMobility->GetPosition());
+            pathLossDb -= txParams->txAntenna->GetGainDb(txAngles);
+        }
+        Ptr<AntennaModel> rxAntenna = DynamicCast<AntennaModel>(rxPhy->GetAntenna());
+        if (rxAntenna)
+        {
+            Angles rxAngles(senderMobility->GetPosition(), receiverMobility->GetPosition());
+            pathLossDb -= rxAntenna->GetGainDb(rxAngles);
+        }
+        if (m_propagationLoss)
+        {
+            ++m_lossComputations;
+            pathLossDb -= m_propagationLoss->CalcRxPower(0, senderMobility, receiverMobility);
+        }
+        if (pathLossDb > m_maxLossDb)
+            return;
+
+        rxParams = txParams->Copy();
+        *(rxParams->psd) *= std::pow(10.0, -pathLossDb / 10.0);
+
+        if (m_propagationDelay)
+            delay = m_propagationDelay->GetDelay(senderMobility, receiverMobility);
+    }
+    else
+    {
+        rxParams = txParams->Copy();
+    }
+
+    ++m_rxEvents;
+    uint32_t context = rxDevice ? rxDevice->GetNode()->GetId() : Simulator::NO_CONTEXT;
+    Simulator::ScheduleWithContext(context, delay,
+                                   &SpatialGridSpectrumChannel::StartRx, this,
+                                   rxParams, rxPhy);
+}
+
+inline void
+SpatialGridSpectrumChannel::StartRx(Ptr<SpectrumSignalParameters> params,
+                                    Ptr<SpectrumPhy> receiver)
+{
+    receiver->StartRx(params);
+}
+
+// ----- Ad-hoc Wi-Fi on the selected channel -----
+// "yans": YansWifiChannelHelper::Default(), as in the original scenarios
+// "grid": the same log-distance/constant-speed models on a grid channel
+// A loss model, if given, replaces the default log-distance one
+inline NetDeviceContainer
+InstallAdhocWifi(WifiHelper &wifi,
+                 WifiMacHelper &mac,
+                 NodeContainer nodes,
+                 std::string channelMode,
+                 Ptr<SpatialGridSpectrumChannel> *gridChannel = nullptr,
+                 Ptr<PropagationLossModel> loss = nullptr)
+{
+    if (channelMode == "yans")
+    {
+        Ptr<YansWifiChannel> channel = YansWifiChannelHelper::Default().Create();
+        if (loss)
+            channel->SetPropagationLossModel(loss);
+
+        YansWifiPhyHelper phy;
+        phy.SetChannel(channel);
+        return wifi.Install(phy, mac, nodes);
+    }
+
+    NS_ABORT_MSG_IF(channelMode != "grid", "Unknown channel mode " << channelMode);
+
+    Ptr<SpatialGridSpectrumChannel> channel = CreateObject<SpatialGridSpectrumChannel>();
+    channel->AddPropagationLossModel(loss ? loss
+                                          : Ptr<PropagationLossModel>(
+                                                CreateObject<LogDistancePropagationLossModel>()));
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    SpectrumWifiPhyHelper phy;
+    phy.SetChannel(channel);
+
+    if (gridChannel)
+        *gridChannel = channel;
+
+    return wifi.Install(phy, mac, nodes);
+}
+
+// ----- Culling report -----
+inline void
+PrintGridChannelStats(Ptr<SpatialGridSpectrumChannel> channel)
+{
+    if (!channel)
+        return;
+
+    std::cout << "\n===== GRID CHANNEL =====\n";
+    std::cout << "Range: " << channel->GetRange() << " m\n";
+    std::cout << "Transmissions: " << channel->GetTransmissions() << "\n";
+    std::cout << "Receivers visited: " << channel->GetCandidates() << "\n";
+    std::cout << "Loss computations: " << channel->GetLossComputations() << "\n";
+    std::cout << "Rx events: " << channel->GetRxEvents() << "\n";
+    std::cout << "Grid rebuilds: " << channel->GetGridRebuilds() << "\n";
+    std::cout << "========================\n";
+}
+
+} // namespace ns3
+
+#endif /* SPATIAL_GRID_SPECTRUM_CHANNEL_H */
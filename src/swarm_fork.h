@@ -0,0 +1,212 @@
+#ifndef SWARM_FORK_H
+#define SWARM_FORK_H
+
+#include "ns3/core-module.h"
+
+#include "swarm_scenario.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace ns3
+{
+
+/*
+ Forked attack sweep
+ - Every variant of an attack sweep replays the same patrol up to
+   attackTime. The sweep runs that prefix once, without an attack, stops
+   at attackTime and fork()s one child per variant from the warm state;
+   the child activates its variant's attack and runs to simTime
+ - Variants may differ only in name, attack, maliciousNodeId and
+   dropProbability; everything else (attackTime included) must match,
+   since it shaped the shared prefix
+ - Each child writes its usual outputs under its own name (the streamed
+   CSVs start with a copy of the prefix rows) and sends its results
+   back through a pipe. With more than one job, a child's console
+   output goes to <name>_swarm.log instead of interleaving
+ - The attack filter is created at the fork point rather than before
+   the run, so random streams differ from an unforked run of the same
+   variant; results agree statistically, not bit for bit
+*/
+struct ForkedRunResult
+{
+    bool ok = false;                // false if the child failed
+    FlowMetrics metrics;
+    double recoveryTime = 0.0;
+    uint64_t controlPackets = 0;
+    double joulesPerBit = 0.0;
+    double txAirtime = 0.0;         // channelStats only
+    uint64_t rxErrors = 0;
+    uint64_t leaderRxPackets = 0;
+    double wallSeconds = 0.0;       // child only, prefix excluded
+};
+
+class ForkedSweep
+{
+  public:
+    explicit ForkedSweep(const std::vector<SwarmScenarioConfig> &variants);
+
+    // Children running at the same time
+    void SetJobs(uint32_t jobs) { m_jobs = std::max(jobs, 1u); }
+
+    std::vector<ForkedRunResult> Run();
+
+    double GetPrefixWallSeconds() const { return m_prefixWall; }
+
+  private:
+    // Serialized config without the fields a variant may change
+    static std::string SharedKey(SwarmScenarioConfig config);
+
+    void RunChild(SwarmScenario &prefix, uint32_t index, int fd) const;
+
+    std::vector<SwarmScenarioConfig> m_variants;
+    uint32_t m_jobs = 1;
+    double m_prefixWall = 0.0;
+};
+
+inline
+ForkedSweep::ForkedSweep(const std::vector<SwarmScenarioConfig> &variants)
+    : m_variants(variants)
+{
+    NS_ABORT_MSG_IF(m_variants.empty(), "A forked sweep needs at least one run");
+
+    std::string key = SharedKey(m_variants[0]);
+    for (const SwarmScenarioConfig &variant : m_variants)
+    {
+        NS_ABORT_MSG_IF(SharedKey(variant) != key,
+                        "Run " << variant.name << " differs from " << m_variants[0].name
+                               << " in more than name, attack, maliciousNodeId and "
+                                  "dropProbability; it cannot share the forked prefix");
+    }
+}
+
+inline std::string
+ForkedSweep::SharedKey(SwarmScenarioConfig config)
+{
+    config.name.clear();
+    config.attack.clear();
+    config.maliciousNodeId = 0;
+    config.dropProbability = 0.0;
+
+    std::ostringstream key;
+    config.ForEachField([&key](const char *name, const char *, auto &field) {
+        key << name << '=' << field << ';';
+    });
+    return key.str();
+}
+
+inline std::vector<ForkedRunResult>
+ForkedSweep::Run()
+{
+    // ----- Shared prefix, up to the attack -----
+    SwarmScenarioConfig base = m_variants[0];
+    base.name = m_variants[0].name + "_prefix";
+    base.attack = "none";
+
+    auto wallStart = std::chrono::steady_clock::now();
+    SwarmScenario prefix(base);
+    prefix.RunPrefix();
+    m_prefixWall =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    std::cout << "[INFO] Shared prefix ran to " << base.attackTime << " s in " << m_prefixWall
+              << " s wall; forking " << m_variants.size() << " run(s), " << m_jobs
+              << " at a time" << std::endl;
+    std::fflush(stdout);
+
+    // ----- One child per variant -----
+    std::vector<ForkedRunResult> results(m_variants.size());
+    std::vector<int> fds(m_variants.size(), -1);
+    std::map<pid_t, uint32_t> running;
+
+    auto reap = [&]() {
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        auto child = running.find(pid);
+        if (child == running.end())
+            return;
+
+        uint32_t i = child->second;
+        running.erase(child);
+
+        ForkedRunResult result;
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 0 &&
+            read(fds[i], &result, sizeof(result)) == ssize_t(sizeof(result)))
+            results[i] = result;
+        else
+            std::cerr << "[WARN] Forked run " << m_variants[i].name << " failed\n";
+        close(fds[i]);
+    };
+
+    for (uint32_t i = 0; i < m_variants.size(); ++i)
+    {
+        while (running.size() >= m_jobs)
+            reap();
+
+        int pipeFds[2];
+        NS_ABORT_MSG_IF(pipe(pipeFds) != 0, "pipe() failed");
+
+        pid_t pid = fork();
+        NS_ABORT_MSG_IF(pid < 0, "fork() failed");
+        if (pid == 0)
+        {
+            close(pipeFds[0]);
+            RunChild(prefix, i, pipeFds[1]);   // does not return
+        }
+
+        close(pipeFds[1]);
+        fds[i] = pipeFds[0];
+        running[pid] = i;
+    }
+    while (!running.empty())
+        reap();
+
+    prefix.Discard();
+    return results;
+}
+
+inline void
+ForkedSweep::RunChild(SwarmScenario &prefix, uint32_t index, int fd) const
+{
+    const SwarmScenarioConfig &variant = m_variants[index];
+
+    if (m_jobs > 1)
+    {
+        std::string log = variant.name + "_swarm.log";
+        if (!std::freopen(log.c_str(), "w", stdout))
+            _exit(1);
+    }
+
+    auto wallStart = std::chrono::steady_clock::now();
+
+    ForkedRunResult result;
+    result.metrics = prefix.ContinueAs(variant);
+    result.recoveryTime = prefix.GetRecoveryTime();
+    result.controlPackets = prefix.GetControlPackets();
+    result.joulesPerBit = prefix.GetJoulesPerBit();
+    result.txAirtime = prefix.GetTxAirtime();
+    result.rxErrors = prefix.GetRxErrors();
+    result.leaderRxPackets = prefix.GetLeaderRxPackets();
+    result.wallSeconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    result.ok = true;
+
+    std::cout.flush();
+    std::fflush(stdout);
+
+    // _exit: the parent's objects and files belong to the parent
+    bool sent = write(fd, &result, sizeof(result)) == ssize_t(sizeof(result));
+    _exit(sent ? 0 : 1);
+}
+
+} // namespace ns3
+
+#endif /* SWARM_FORK_H */
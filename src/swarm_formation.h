@@ -0,0 +1,370 @@
+#ifndef SWARM_FORMATION_H
+#define SWARM_FORMATION_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+namespace ns3
+{
+
+/*
+ Swarm formation engine
+ - Follower offsets are kept as structure-of-arrays
+ - Followers use FormationFollowerMobilityModel, which reads its offset
+   from here on demand, so the formation schedules no position updates
+ - Works for any number of followers: an offset table shorter than the
+   swarm is filled outward ring by ring (see ExpandOffsets), or a table of
+   exactly the right size is generated (see GenerateFormation)
+ - Formation changes are instant (SetOffsets) or interpolated over a
+   transition time (TransitionTo); followers blend between the two
+   tables lazily, so a transition costs no extra events
+*/
+
+// ----- Formation tables (6-follower unit) -----
+inline std::vector<Vector>
+TightFormationOffsets()
+{
+    return {
+        Vector(-40.0,  0.0, 0.0),
+        Vector( 40.0,  0.0, 0.0),
+        Vector(  0.0, 40.0, 0.0),
+        Vector(  0.0,-40.0, 0.0),
+        Vector(-30.0, 30.0, 0.0),
+        Vector( 30.0,-30.0, 0.0)
+    };
+}
+
+inline std::vector<Vector>
+WideFormationOffsets()
+{
+    return {
+        Vector(-90.0,  0.0, 0.0),
+        Vector( 90.0,  0.0, 0.0),
+        Vector(  0.0, 90.0, 0.0),
+        Vector(  0.0,-90.0, 0.0),
+        Vector(-65.0, 65.0, 0.0),
+        Vector( 65.0,-65.0, 0.0)
+    };
+}
+
+// ----- Stretch a table to n followers -----
+// The table is ring 1. Ring r holds r * k slots: the table scaled by r
+// plus r - 1 evenly spaced slots along each edge between angularly
+// adjacent entries (a hex fill when the table is a hexagon). Slot
+// spacing stays near the table's, and the swarm radius grows with
+// sqrt(n) instead of n / k
+inline std::vector<Vector>
+ExpandOffsets(const std::vector<Vector> &table, uint32_t n)
+{
+    NS_ABORT_MSG_IF(table.empty() && n > 0, "Empty formation table");
+
+    std::vector<Vector> offsets;
+    offsets.reserve(n);
+    const uint32_t k = table.size();
+
+    for (uint32_t i = 0; i < n && i < k; ++i)
+        offsets.push_back(table[i]);
+    if (n <= k)
+        return offsets;
+
+    // Outer rings walk the table's polygon in angle order
+    std::vector<Vector> corners = table;
+    std::sort(corners.begin(), corners.end(), [](const Vector &a, const Vector &b) {
+        return std::atan2(a.y, a.x) < std::atan2(b.y, b.x);
+    });
+
+    for (uint32_t ring = 2; offsets.size() < n; ++ring)
+    {
+        for (uint32_t j = 0; j < k && offsets.size() < n; ++j)
+        {
+            const Vector &from = corners[j];
+            const Vector &to = corners[(j + 1) % k];
+            for (uint32_t step = 0; step < ring && offsets.size() < n; ++step)
+            {
+                offsets.push_back(Vector(from.x * ring + (to.x - from.x) * step,
+                                         from.y * ring + (to.y - from.y) * step,
+                                         from.z * ring + (to.z - from.z) * step));
+            }
+        }
+    }
+    return offsets;
+}
+
+// ----- Offset table from text -----
+// "x,y[,z];x,y[,z];..." e.g. "-40,0;40,0;0,40". Empty text = fallback
+inline std::vector<Vector>
+ParseOffsets(const std::string &text, const std::vector<Vector> &fallback)
+{
+    if (text.empty())
+        return fallback;
+
+    std::vector<Vector> table;
+    std::istringstream entries(text);
+    std::string entry;
+    while (std::getline(entries, entry, ';'))
+    {
+        double c[3] = {0.0, 0.0, 0.0};
+        std::istringstream fields(entry);
+        std::string field;
+        uint32_t n = 0;
+        while (n < 3 && std::getline(fields, field, ','))
+        {
+            std::istringstream value(field);
+            NS_ABORT_MSG_IF(!(value >> c[n]), "Bad formation offset '" << entry << "'");
+            ++n;
+        }
+        NS_ABORT_MSG_IF(n < 2, "Formation offset '" << entry << "' needs x,y");
+        table.push_back(Vector(c[0], c[1], c[2]));
+    }
+    NS_ABORT_MSG_IF(table.empty(), "Empty formation table '" << text << "'");
+    return table;
+}
+
+// ----- Parametric formations for any follower count -----
+// Offsets are relative to the leader; spacing is the distance between
+// neighboring slots. Generated once per formation, then reused
+//   line   abreast of the leader, alternating sides
+//   wedge  V behind the leader, one pair per row
+//   ring   circle around the leader, neighbors spacing apart
+//   grid   square lattice, nearest slots first
+//   hex    hexagonal lattice, filled ring by ring
+inline std::vector<Vector>
+GenerateFormation(const std::string &shape, uint32_t n, double spacing)
+{
+    std::vector<Vector> offsets;
+    offsets.reserve(n);
+
+    if (shape == "line")
+    {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            double side = (i % 2 == 0) ? 1.0 : -1.0;
+            offsets.push_back(Vector(0.0, side * spacing * (i / 2 + 1), 0.0));
+        }
+    }
+    else if (shape == "wedge")
+    {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            double row = i / 2 + 1;
+            double side = (i % 2 == 0) ? 1.0 : -1.0;
+            offsets.push_back(Vector(-row * spacing, side * row * spacing, 0.0));
+        }
+    }
+    else if (shape == "ring")
+    {
+        // Chord between neighbors = spacing
+        double radius = (n > 1) ? spacing / (2.0 * std::sin(M_PI / n)) : spacing;
+        radius = std::max(radius, spacing);
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            double a = 2.0 * M_PI * i / n;
+            offsets.push_back(Vector(radius * std::cos(a), radius * std::sin(a), 0.0));
+        }
+    }
+    else if (shape == "grid")
+    {
+        // Lattice around the leader's slot, nearest first, ties by angle
+        int32_t half = static_cast<int32_t>(std::ceil(std::sqrt(n + 1.0) / 2.0));
+        std::vector<std::pair<int32_t, int32_t>> cells;
+        for (int32_t x = -half; x <= half; ++x)
+        {
+            for (int32_t y = -half; y <= half; ++y)
+            {
+                if (x != 0 || y != 0)
+                    cells.emplace_back(x, y);
+            }
+        }
+        std::sort(cells.begin(), cells.end(), [](const auto &a, const auto &b) {
+            int32_t da = a.first * a.first + a.second * a.second;
+            int32_t db = b.first * b.first + b.second * b.second;
+            if (da != db)
+                return da < db;
+            return std::atan2(a.second, a.first) < std::atan2(b.second, b.first);
+        });
+        for (uint32_t i = 0; i < n; ++i)
+            offsets.push_back(Vector(cells[i].first * spacing, cells[i].second * spacing, 0.0));
+    }
+    else if (shape == "hex")
+    {
+        // Axial coordinates: ring k holds 6k slots, walked side by side
+        static const int32_t dir[6][2] = {{1, 0}, {1, -1}, {0, -1}, {-1, 0}, {-1, 1}, {0, 1}};
+        for (int32_t k = 1; offsets.size() < n; ++k)
+        {
+            int32_t q = -k;
+            int32_t r = k;   // start corner: k steps along direction 4 from the origin
+            for (uint32_t side = 0; side < 6 && offsets.size() < n; ++side)
+            {
+                for (int32_t step = 0; step < k && offsets.size() < n; ++step)
+                {
+                    double x = spacing * (q + r / 2.0);
+                    double y = spacing * (std::sqrt(3.0) / 2.0) * r;
+                    offsets.push_back(Vector(x, y, 0.0));
+                    q += dir[side][0];
+                    r += dir[side][1];
+                }
+            }
+        }
+    }
+    else
+    {
+        NS_ABORT_MSG("Unknown formation shape " << shape);
+    }
+    return offsets;
+}
+
+class SwarmFormation
+{
+  public:
+    // Size the offset tables for the followers
+    void Attach(Ptr<Node> leader, const NodeContainer &followers);
+
+    // Install a new offset table (expanded to the follower count)
+    void SetOffsets(const std::vector<Vector> &table);
+
+    // Move every follower from its current offset to the new table along
+    // a straight line over duration (duration <= 0 is SetOffsets)
+    void TransitionTo(const std::vector<Vector> &table, Time duration);
+
+    // Called after every offset change, e.g. so lazily evaluated
+    // followers can announce the jump as a course change
+    void AddChangeListener(Callback<void> listener) { m_listeners.push_back(listener); }
+
+    uint32_t GetN() const { return m_offX.size(); }
+    Vector GetOffset(uint32_t i) const;
+    Vector GetOffsetVelocity(uint32_t i) const;
+
+  private:
+    // Fraction of the running transition done at the current time
+    // (1 when none is running)
+    double Progress() const;
+
+    void NotifyListeners();
+
+    // Target offsets; during a transition followers blend from m_from*
+    std::vector<double> m_offX, m_offY, m_offZ;
+    std::vector<double> m_fromX, m_fromY, m_fromZ;
+    Time m_transitionStart;
+    Time m_transitionEnd;
+    EventId m_transitionDone;
+
+    std::vector<Callback<void>> m_listeners;
+};
+
+inline void
+SwarmFormation::Attach(Ptr<Node> leader, const NodeContainer &followers)
+{
+    NS_ABORT_MSG_IF(!leader->GetObject<MobilityModel>(), "Leader has no mobility model");
+
+    uint32_t n = followers.GetN();
+    m_offX.assign(n, 0.0);
+    m_offY.assign(n, 0.0);
+    m_offZ.assign(n, 0.0);
+    m_fromX.assign(n, 0.0);
+    m_fromY.assign(n, 0.0);
+    m_fromZ.assign(n, 0.0);
+}
+
+inline void
+SwarmFormation::SetOffsets(const std::vector<Vector> &table)
+{
+    std::vector<Vector> offsets = ExpandOffsets(table, GetN());
+
+    for (uint32_t i = 0; i < offsets.size(); ++i)
+    {
+        m_offX[i] = offsets[i].x;
+        m_offY[i] = offsets[i].y;
+        m_offZ[i] = offsets[i].z;
+    }
+
+    m_transitionDone.Cancel();
+    m_transitionStart = m_transitionEnd = Simulator::Now();
+    NotifyListeners();
+}
+
+inline void
+SwarmFormation::TransitionTo(const std::vector<Vector> &table, Time duration)
+{
+    if (!duration.IsStrictlyPositive())
+    {
+        SetOffsets(table);
+        return;
+    }
+
+    // Start from wherever the followers are now, even mid-transition
+    for (uint32_t i = 0; i < GetN(); ++i)
+    {
+        Vector current = GetOffset(i);
+        m_fromX[i] = current.x;
+        m_fromY[i] = current.y;
+        m_fromZ[i] = current.z;
+    }
+
+    std::vector<Vector> offsets = ExpandOffsets(table, GetN());
+    for (uint32_t i = 0; i < offsets.size(); ++i)
+    {
+        m_offX[i] = offsets[i].x;
+        m_offY[i] = offsets[i].y;
+        m_offZ[i] = offsets[i].z;
+    }
+
+    m_transitionStart = Simulator::Now();
+    m_transitionEnd = m_transitionStart + duration;
+
+    // Listeners hear the start (velocity gains the offset drift) and
+    // the end (drift stops); positions in between are interpolated
+    m_transitionDone.Cancel();
+    m_transitionDone = Simulator::Schedule(duration, &SwarmFormation::NotifyListeners, this);
+    NotifyListeners();
+}
+
+inline double
+SwarmFormation::Progress() const
+{
+    Time now = Simulator::Now();
+    if (now >= m_transitionEnd)
+        return 1.0;
+    return (now - m_transitionStart).GetSeconds() /
+           (m_transitionEnd - m_transitionStart).GetSeconds();
+}
+
+inline Vector
+SwarmFormation::GetOffset(uint32_t i) const
+{
+    double a = Progress();
+    if (a >= 1.0)
+        return Vector(m_offX[i], m_offY[i], m_offZ[i]);
+    return Vector(m_fromX[i] + a * (m_offX[i] - m_fromX[i]),
+                  m_fromY[i] + a * (m_offY[i] - m_fromY[i]),
+                  m_fromZ[i] + a * (m_offZ[i] - m_fromZ[i]));
+}
+
+inline Vector
+SwarmFormation::GetOffsetVelocity(uint32_t i) const
+{
+    if (Progress() >= 1.0)
+        return Vector(0.0, 0.0, 0.0);
+    double d = (m_transitionEnd - m_transitionStart).GetSeconds();
+    return Vector((m_offX[i] - m_fromX[i]) / d,
+                  (m_offY[i] - m_fromY[i]) / d,
+                  (m_offZ[i] - m_fromZ[i]) / d);
+}
+
+inline void
+SwarmFormation::NotifyListeners()
+{
+    for (auto &listener : m_listeners)
+    {
+        listener();
+    }
+}
+
+} // namespace ns3
+
+#endif /* SWARM_FORMATION_H */
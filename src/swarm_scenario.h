@@ -0,0 +1,1014 @@
+#ifndef SWARM_SCENARIO_H
+#define SWARM_SCENARIO_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/flow-monitor-module.h"
+#include "ns3/aodv-module.h"
+#include "ns3/olsr-module.h"
+#include "ns3/dsdv-module.h"
+
+#include "swarm_formation.h"
+#include "formation_follower_mobility_model.h"
+#include "spatial_grid_spectrum_channel.h"
+#include "flow_stats_stream.h"
+#include "windowed_metrics.h"
+#include "manet_metrics.h"
+#include "forwarding_attack.h"
+#include "routing_instrumentation.h"
+#include "sim_profiler.h"
+#include "json_config.h"
+#include "cluster_aggregation.h"
+#include "channel_load_monitor.h"
+#include "wifi_config.h"
+#include "mission_traffic.h"
+#include "watchdog_detector.h"
+#include "route_mitigation.h"
+#include "energy_accounting.h"
+#include "cached_propagation_loss_model.h"
+#include "scheduler_config.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <memory>
+#include <sstream>
+
+namespace ns3
+{
+
+/*
+ PATROL SWARM SCENARIO
+ - Leader (node 0) patrols a patrolSize square at patrolSpeed
+ - Followers hold formation with a lag, tight -> wide at 30 s, back at 60 s;
+   explicit offset tables win over a generated formationShape, which wins
+   over the built-in tables. transitionTime > 0 morphs instead of jumping
+ - Followers send a payloadSize-byte (64) echo heartbeat to the leader every heartbeatInterval,
+   routed by AODV, OLSR or DSDV (or one hop only with routing=none).
+   With traffic=cluster, units of clusterSize followers send to their
+   cluster head instead, which forwards one aggregate per interval.
+   traffic=mission replaces heartbeats with telemetry (payloadSize every
+   heartbeatInterval), sensor bursts, video and C2 (mission_traffic.h)
+ - An AttackModel is installed once the network exists and activated
+   at attackTime; with watchdog, every node runs a WatchdogDetector, and
+   with mitigation each node also stops listening to neighbors it flags
+ - Every run records routing control overhead (routingStats, on by
+   default). channelStats adds the channel load block, which hooks
+   every PHY state change on every node, so it is off unless asked for
+ - With energy, every node's radio draws from a battery share
+   (energy_accounting.h); the run reports J per delivered bit, per
+   formation phase and before/after the attack
+ - Outputs <name>_swarm_flows.csv, <name>_swarm_windows.csv and, with
+   xmlOutput, <name>_swarm.xml; with energy, <name>_swarm_energy.csv
+*/
+struct SwarmScenarioConfig
+{
+    std::string name = "baseline";   // output file prefix
+    std::string attack = "none";     // none, blackhole or grayhole
+
+    uint32_t nNodes = 7;
+    double simTime = 90.0;
+    double attackTime = 45.0;
+    uint32_t maliciousNodeId = 2;
+    double dropProbability = 0.3;    // grayhole only
+
+    double patrolSize = 300.0;       // 300x300 area
+    double patrolSpeed = 10.0;       // m/s
+    double formationScale = 1.0;     // multiplies the tight/wide offset tables
+    std::string tightOffsets;        // "x,y;x,y;...", empty = built-in table
+    std::string wideOffsets;
+    std::string formationShape;      // line, wedge, ring, grid, hex; empty = tables
+    double tightSpacing = 40.0;      // m between neighbors, generated shapes only
+    double wideSpacing = 90.0;
+    double transitionTime = 0.0;     // s to morph between formations, 0 = instant
+    double heartbeatInterval = 2.0;  // s
+    std::string traffic = "flat";    // flat (echo to leader), cluster or mission
+    uint32_t clusterSize = 6;        // followers per cluster, head included
+    uint32_t videoSources = 1;       // mission: followers streaming video
+    double videoRateKbps = 256.0;
+    uint32_t sensorBurst = 16;       // mission: packets per sensor upload
+    std::string subnet = "10.2.1.0";
+    std::string routing = "aodv";    // aodv, olsr, dsdv or none (one hop only)
+
+    std::string channelMode = "yans";
+    bool cacheLoss = false;          // memoize loss per pair while its distance holds
+    std::string wifiStandard = "b";     // b, g, n or ac
+    std::string rateControl = "default"; // default, ideal, minstrel-ht or constant
+    std::string dataMode;            // constant rate only, empty = standard's top rate
+    uint32_t payloadSize = 64;       // heartbeat payload (bytes)
+    double statsInterval = 1.0;
+    double window = 1.0;
+    bool xmlOutput = false;
+    bool routingStats = true;        // routing control overhead (IPv4 Tx/Rx on every node)
+    bool channelStats = false;       // airtime, failed receptions and leader load
+    bool watchdog = false;           // per-node forwarding watchdog
+    double watchdogWindow = 5.0;     // s, evidence decay time constant
+    double watchdogThreshold = 0.75; // flag below this forwarding ratio
+    double detectionDeadline = 10.0; // s after attackTime, for the report
+    bool mitigation = false;         // blacklist flagged nodes (implies watchdog)
+    bool energy = false;             // radio energy accounting
+    double initialEnergy = 100.0;    // J per node, radio share of the battery
+    double energySampleInterval = 1.0;  // s between depletion samples
+
+    std::string scheduler = "map";   // map, heap, calendar, list or priority
+    std::string profile;             // JSON lines file, empty = no profiling
+    uint32_t rngRun = 0;             // 0 = keep the global RngRun
+
+    // Every field with its option name and help text, used for the
+    // command line and for scenario files alike
+    template <typename F>
+    void ForEachField(F &&f);
+
+    // baseline, blackhole or grayhole: sets name, attack and subnet
+    void ApplyPreset(const std::string &preset);
+    void AddCommandLineValues(CommandLine &cmd);
+
+    // Set one field from text; false if there is no such field
+    bool Set(const std::string &key, const std::string &value);
+
+    // Apply a JSON object's members in order. "preset" is applied first
+    void Apply(const JsonValue &object);
+};
+
+template <typename F>
+void
+SwarmScenarioConfig::ForEachField(F &&f)
+{
+    f("name", "Scenario name (output file prefix)", name);
+    f("attack", "Attack: none, blackhole or grayhole", attack);
+    f("nNodes", "Swarm size (leader + followers)", nNodes);
+    f("simTime", "Simulation time (s)", simTime);
+    f("attackTime", "Attack activation time (s)", attackTime);
+    f("maliciousNodeId", "Malicious node index", maliciousNodeId);
+    f("dropProbability", "Grayhole drop probability", dropProbability);
+    f("patrolSize", "Patrol square side (m)", patrolSize);
+    f("patrolSpeed", "Leader speed (m/s)", patrolSpeed);
+    f("formationScale", "Formation spacing multiplier", formationScale);
+    f("tightOffsets", "Tight formation offsets x,y[,z];... (empty = built-in)", tightOffsets);
+    f("wideOffsets", "Wide formation offsets x,y[,z];... (empty = built-in)", wideOffsets);
+    f("formationShape", "Generated formation: line, wedge, ring, grid or hex (empty = tables)",
+      formationShape);
+    f("tightSpacing", "Neighbor spacing of the tight generated formation (m)", tightSpacing);
+    f("wideSpacing", "Neighbor spacing of the wide generated formation (m)", wideSpacing);
+    f("transitionTime", "Time to morph between formations (s, 0 = instant)", transitionTime);
+    f("heartbeatInterval", "Follower heartbeat interval (s)", heartbeatInterval);
+    f("traffic", "Traffic: flat (echo to leader), cluster (aggregated) or mission", traffic);
+    f("clusterSize", "Followers per cluster for traffic=cluster", clusterSize);
+    f("videoSources", "Followers streaming video for traffic=mission", videoSources);
+    f("videoRateKbps", "Video bitrate per source for traffic=mission (kbps)", videoRateKbps);
+    f("sensorBurst", "Packets per sensor upload for traffic=mission", sensorBurst);
+    f("subnet", "IPv4 network of the swarm", subnet);
+    f("routing", "Routing protocol: aodv, olsr, dsdv or none", routing);
+    f("channelMode", "Wi-Fi channel: yans or grid (spatially culled)", channelMode);
+    f("cacheLoss", "Memoize propagation loss per node pair while its distance holds", cacheLoss);
+    f("wifiStandard", "Wi-Fi standard: b, g, n or ac", wifiStandard);
+    f("rateControl", "Rate control: default, ideal, minstrel-ht or constant", rateControl);
+    f("dataMode", "Data mode for constant rate control (empty = standard's top rate)", dataMode);
+    f("payloadSize", "Heartbeat payload size (bytes)", payloadSize);
+    f("statsInterval", "Per-flow stats streaming interval (s)", statsInterval);
+    f("window", "Windowed metrics width (s)", window);
+    f("xmlOutput", "Also write the full FlowMonitor XML at the end", xmlOutput);
+    f("routingStats", "Count routing control packets and bytes on every node", routingStats);
+    f("channelStats", "Report airtime, failed receptions and leader load", channelStats);
+    f("watchdog", "Run the watchdog attack detector on every node", watchdog);
+    f("watchdogWindow", "Watchdog evidence decay time constant (s)", watchdogWindow);
+    f("watchdogThreshold", "Watchdog flags neighbors forwarding less than this", watchdogThreshold);
+    f("detectionDeadline", "Expected detection time after the attack starts (s)",
+      detectionDeadline);
+    f("mitigation", "Blacklist nodes the watchdog flags, so AODV routes around them",
+      mitigation);
+    f("energy", "Radio energy accounting (J/bit, depletion CSV)", energy);
+    f("initialEnergy", "Radio energy budget per node (J)", initialEnergy);
+    f("energySampleInterval", "Time between energy depletion samples (s)",
+      energySampleInterval);
+    f("scheduler", "Event scheduler: map, heap, calendar, list or priority", scheduler);
+    f("profile", "Append a JSON run profile to this file", profile);
+    f("rngRun", "RngRun for this scenario (0 = global value)", rngRun);
+}
+
+inline void
+SwarmScenarioConfig::ApplyPreset(const std::string &preset)
+{
+    name = preset;
+
+    if (preset == "baseline")
+    {
+        attack = "none";
+        subnet = "10.2.1.0";
+    }
+    else if (preset == "blackhole")
+    {
+        attack = "blackhole";
+        subnet = "10.3.1.0";
+    }
+    else if (preset == "grayhole")
+    {
+        attack = "grayhole";
+        subnet = "10.4.1.0";
+    }
+    else
+    {
+        NS_ABORT_MSG("Unknown scenario " << preset);
+    }
+}
+
+inline void
+SwarmScenarioConfig::AddCommandLineValues(CommandLine &cmd)
+{
+    ForEachField([&cmd](const char *key, const char *help, auto &field) {
+        cmd.AddValue(key, help, field);
+    });
+}
+
+// ----- Text to field value -----
+inline bool
+ParseField(const std::string &text, std::string &field)
+{
+    field = text;
+    return true;
+}
+
+inline bool
+ParseField(const std::string &text, bool &field)
+{
+    if (text == "true" || text == "1")
+        field = true;
+    else if (text == "false" || text == "0")
+        field = false;
+    else
+        return false;
+    return true;
+}
+
+template <typename T>
+bool
+ParseField(const std::string &text, T &field)
+{
+    std::istringstream in(text);
+    T value;
+    if (!(in >> value) || !(in >> std::ws).eof())
+        return false;
+    field = value;
+    return true;
+}
+
+inline bool
+SwarmScenarioConfig::Set(const std::string &key, const std::string &value)
+{
+    bool found = false;
+    ForEachField([&](const char *name, const char *, auto &field) {
+        if (found || key != name)
+            return;
+        found = true;
+        NS_ABORT_MSG_IF(!ParseField(value, field), "Bad value '" << value << "' for " << key);
+    });
+    return found;
+}
+
+inline void
+SwarmScenarioConfig::Apply(const JsonValue &object)
+{
+    NS_ABORT_MSG_IF(object.type != JsonValue::OBJECT, "Scenario entry must be a JSON object");
+
+    if (const JsonValue *preset = object.Find("preset"))
+        ApplyPreset(preset->text);
+
+    for (const auto &member : object.members)
+    {
+        if (member.first == "preset" || member.second.type != JsonValue::SCALAR)
+            continue;
+        NS_ABORT_MSG_IF(!Set(member.first, member.second.text),
+                        "Unknown scenario field '" << member.first << "'");
+    }
+}
+
+// ----- Attack models -----
+
+/*
+ Strategy applied to one scenario run
+ - Install() once the devices and stack exist, before Simulator::Run()
+ - Activate() at the scenario's attack time
+ - PrintSummary() after the run
+*/
+class AttackModel : public SimpleRefCount<AttackModel>
+{
+  public:
+    virtual ~AttackModel() {}
+
+    virtual std::string GetName() const = 0;
+    virtual void Install(const NodeContainer &nodes) {}
+    virtual void Activate() {}
+    virtual void PrintSummary() const {}
+};
+
+class NoAttack : public AttackModel
+{
+  public:
+    std::string GetName() const override { return "none"; }
+};
+
+/*
+ Malicious node drops packets it should forward
+ - A ForwardingAttackFilter is added (inactive) to the node's routing
+   list at Install() and switched on at Activate(), so only transit
+   packets are dropped and the node's own traffic is unaffected
+*/
+class ForwardingAttack : public AttackModel
+{
+  public:
+    ForwardingAttack(const std::string &name, uint32_t nodeId, double dropProbability)
+        : m_name(name),
+          m_nodeId(nodeId),
+          m_dropProbability(dropProbability)
+    {
+    }
+
+    std::string GetName() const override { return m_name; }
+    void Install(const NodeContainer &nodes) override;
+    void Activate() override;
+    void PrintSummary() const override;
+
+  protected:
+    std::string m_name;
+    uint32_t m_nodeId;
+    double m_dropProbability;
+    Ptr<ForwardingAttackFilter> m_filter;
+};
+
+inline void
+ForwardingAttack::Install(const NodeContainer &nodes)
+{
+    NS_ABORT_MSG_IF(m_nodeId >= nodes.GetN(), "Malicious node " << m_nodeId << " does not exist");
+    m_filter = InstallForwardingAttackFilter(nodes.Get(m_nodeId), m_dropProbability);
+}
+
+inline void
+ForwardingAttack::Activate()
+{
+    m_filter->SetActive(true);
+
+    std::string label = m_name;
+    label[0] = std::toupper(label[0]);
+
+    std::cout << "[INFO] " << label << " attack activated at "
+              << Simulator::Now().GetSeconds() << "s on node " << m_nodeId;
+    if (m_dropProbability < 1.0)
+        std::cout << " (p=" << m_dropProbability << ")";
+    std::cout << std::endl;
+}
+
+inline void
+ForwardingAttack::PrintSummary() const
+{
+    std::cout << "[INFO] Node " << m_nodeId << " dropped "
+              << m_filter->GetDroppedPackets() << " of "
+              << m_filter->GetTransitPackets() << " transit packets\n";
+}
+
+// Drops every packet in transit
+class BlackholeAttack : public ForwardingAttack
+{
+  public:
+    explicit BlackholeAttack(uint32_t nodeId) : ForwardingAttack("blackhole", nodeId, 1.0) {}
+};
+
+// Drops each packet in transit with probability p
+class GrayholeAttack : public ForwardingAttack
+{
+  public:
+    GrayholeAttack(uint32_t nodeId, double dropProbability)
+        : ForwardingAttack("grayhole", nodeId, dropProbability)
+    {
+    }
+};
+
+inline Ptr<AttackModel>
+CreateAttackModel(const SwarmScenarioConfig &config)
+{
+    if (config.attack == "none")
+        return Create<NoAttack>();
+    if (config.attack == "blackhole")
+        return Create<BlackholeAttack>(config.maliciousNodeId);
+    if (config.attack == "grayhole")
+        return Create<GrayholeAttack>(config.maliciousNodeId, config.dropProbability);
+
+    NS_ABORT_MSG("Unknown attack " << config.attack);
+    return nullptr;
+}
+
+// ----- Scenario -----
+
+/*
+ One run of the patrol swarm
+ - Run() builds the nodes, mobility, Wi-Fi, stack and traffic from the
+   config, runs the simulator, prints the metrics and calls
+   Simulator::Destroy(), so several scenarios can run back-to-back in
+   one process. Each SwarmScenario object runs once
+*/
+class SwarmScenario
+{
+  public:
+    SwarmScenario(const SwarmScenarioConfig &config, Ptr<AttackModel> attack);
+    explicit SwarmScenario(const SwarmScenarioConfig &config);
+
+    FlowMetrics Run();
+
+    // Forked sweeps (swarm_fork.h). RunPrefix() runs without an attack up
+    // to attackTime and stops; ContinueAs() then finishes the run as one
+    // variant (in a forked child), and Discard() drops the prefix and its
+    // output files (in the parent, once the children are done)
+    void RunPrefix();
+    FlowMetrics ContinueAs(const SwarmScenarioConfig &variant);
+    void Discard();
+
+    // Results beyond the flow metrics, valid after Run()/ContinueAs()
+    double GetRecoveryTime() const { return m_recoveryTime; }
+    uint64_t GetControlPackets() const { return m_controlPackets; }
+    double GetJoulesPerBit() const { return m_joulesPerBit; }   // 0 without energy
+    // Channel load, 0 without channelStats
+    double GetTxAirtime() const { return m_txAirtime; }          // s, all nodes
+    uint64_t GetRxErrors() const { return m_rxErrors; }
+    uint64_t GetLeaderRxPackets() const { return m_leaderRxPackets; }
+
+  private:
+    void BuildMobility();
+    void BuildNetwork();
+    void BuildTraffic();
+    void Build();
+    void Instrument();
+    FlowMetrics Report();
+    void SetLeaderVelocity(Vector v);
+    void PrintHeartbeats(Ptr<FlowMonitor> monitor, Ptr<Ipv4FlowClassifier> classifier) const;
+    std::vector<Vector> Scaled(std::vector<Vector> table) const;
+    std::vector<Vector> FormationTable(bool wide) const;
+
+    SwarmScenarioConfig m_config;
+    Ptr<AttackModel> m_attack;
+
+    NodeContainer m_nodes;
+    Ptr<Node> m_leader;
+    NodeContainer m_followers;
+    SwarmFormation m_formation;
+    NetDeviceContainer m_devices;
+    Ptr<SpatialGridSpectrumChannel> m_gridChannel;
+    Ptr<CachedPropagationLossModel> m_lossCache;      // cacheLoss only
+
+    Ptr<AggregateSink> m_sink;                        // traffic=cluster only
+    std::vector<Ptr<ClusterHeadAggregator>> m_heads;
+    MissionTrafficStats m_mission;                    // traffic=mission only
+
+    // Instruments, created by Instrument()
+    SimProfiler m_profiler;
+    std::unique_ptr<WatchdogDetector> m_watchdog;
+    RouteMitigation m_mitigation;
+    std::unique_ptr<RoutingOverheadMonitor> m_routingMonitor;
+    std::unique_ptr<ChannelLoadMonitor> m_channelLoad;
+    std::unique_ptr<WindowedMetrics> m_windowed;
+    FlowMonitorHelper m_flowHelper;
+    Ptr<FlowMonitor> m_flowMonitor;
+    Ptr<Ipv4FlowClassifier> m_classifier;
+    std::unique_ptr<FlowStatsStreamWriter> m_flowStream;
+    std::unique_ptr<EnergyAccounting> m_energy;
+
+    double m_recoveryTime = 0.0;
+    uint64_t m_controlPackets = 0;
+    double m_joulesPerBit = 0.0;
+    double m_txAirtime = 0.0;
+    uint64_t m_rxErrors = 0;
+    uint64_t m_leaderRxPackets = 0;
+};
+
+inline
+SwarmScenario::SwarmScenario(const SwarmScenarioConfig &config, Ptr<AttackModel> attack)
+    : m_config(config),
+      m_attack(attack)
+{
+}
+
+inline
+SwarmScenario::SwarmScenario(const SwarmScenarioConfig &config)
+    : SwarmScenario(config, CreateAttackModel(config))
+{
+}
+
+inline void
+SwarmScenario::SetLeaderVelocity(Vector v)
+{
+    m_leader->GetObject<ConstantVelocityMobilityModel>()->SetVelocity(v);
+}
+
+inline std::vector<Vector>
+SwarmScenario::Scaled(std::vector<Vector> table) const
+{
+    for (Vector &v : table)
+        v = Vector(v.x * m_config.formationScale,
+                   v.y * m_config.formationScale,
+                   v.z * m_config.formationScale);
+    return table;
+}
+
+inline std::vector<Vector>
+SwarmScenario::FormationTable(bool wide) const
+{
+    const std::string &text = wide ? m_config.wideOffsets : m_config.tightOffsets;
+    std::vector<Vector> fallback;
+    if (!m_config.formationShape.empty())
+        fallback = GenerateFormation(m_config.formationShape, m_followers.GetN(),
+                                     wide ? m_config.wideSpacing : m_config.tightSpacing);
+    else
+        fallback = wide ? WideFormationOffsets() : TightFormationOffsets();
+    return Scaled(ParseOffsets(text, fallback));
+}
+
+inline void
+SwarmScenario::BuildMobility()
+{
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
+    mobility.Install(m_leader);
+
+    // Followers compute their position from the leader on demand
+    mobility.SetMobilityModel("ns3::FormationFollowerMobilityModel",
+                              "Lag", TimeValue(Seconds(2.0)));
+    mobility.Install(m_followers);
+
+    m_leader->GetObject<MobilityModel>()->SetPosition(Vector(0.0, 0.0, 0.0));
+
+    m_formation.Attach(m_leader, m_followers);
+    m_formation.SetOffsets(FormationTable(false));
+    BindFormationFollowers(m_formation, m_leader, m_followers);
+
+    // Leader patrol: square loop
+    double size = m_config.patrolSize;
+    double speed = m_config.patrolSpeed;
+
+    Simulator::Schedule(Seconds(0.0), &SwarmScenario::SetLeaderVelocity, this,
+                        Vector(speed, 0.0, 0.0));     // Right
+    Simulator::Schedule(Seconds(size / speed), &SwarmScenario::SetLeaderVelocity, this,
+                        Vector(0.0, speed, 0.0));     // Up
+    Simulator::Schedule(Seconds(2 * size / speed), &SwarmScenario::SetLeaderVelocity, this,
+                        Vector(-speed, 0.0, 0.0));    // Left
+    Simulator::Schedule(Seconds(3 * size / speed), &SwarmScenario::SetLeaderVelocity, this,
+                        Vector(0.0, -speed, 0.0));    // Down
+
+    // Formation dynamics (tables built once, transitions start at 30/60 s)
+    Time transition = Seconds(m_config.transitionTime);
+    Simulator::Schedule(Seconds(30.0), &SwarmFormation::TransitionTo, &m_formation,
+                        FormationTable(true), transition);
+    Simulator::Schedule(Seconds(60.0), &SwarmFormation::TransitionTo, &m_formation,
+                        FormationTable(false), transition);
+}
+
+inline void
+SwarmScenario::BuildNetwork()
+{
+    // ----- Wi-Fi ad-hoc -----
+    WifiHelper wifi;
+    ConfigureWifi(wifi, m_config.wifiStandard, m_config.rateControl, m_config.dataMode);
+
+    // Mission classes are told apart by TOS, which needs a QoS MAC
+    WifiMacHelper mac;
+    if (m_config.traffic == "mission")
+        mac.SetType("ns3::AdhocWifiMac", "QosSupported", BooleanValue(true));
+    else
+        mac.SetType("ns3::AdhocWifiMac");
+
+    // Follower offsets hold between formation switches, so pair distances
+    // repeat while the formation moves; a millimetre is far below 0.001 dB
+    if (m_config.cacheLoss)
+    {
+        m_lossCache = CreateObject<CachedPropagationLossModel>();
+        m_lossCache->SetAttribute("DistanceOnly", BooleanValue(true));
+        m_lossCache->SetAttribute("Tolerance", DoubleValue(0.001));
+    }
+
+    m_devices = InstallAdhocWifi(wifi, mac, m_nodes, m_config.channelMode, &m_gridChannel,
+                                 m_lossCache);
+
+    // The grid's drift allowance must cover the fastest node: the patrol
+    // speed plus the largest offset drift during a formation transition
+    if (m_gridChannel)
+    {
+        double drift = 0.0;
+        if (m_config.transitionTime > 0.0)
+        {
+            std::vector<Vector> tight = ExpandOffsets(FormationTable(false), m_followers.GetN());
+            std::vector<Vector> wide = ExpandOffsets(FormationTable(true), m_followers.GetN());
+            for (uint32_t i = 0; i < tight.size(); ++i)
+                drift = std::max(drift, CalculateDistance(tight[i], wide[i]));
+            drift /= m_config.transitionTime;
+        }
+        m_gridChannel->SetAttribute("MaxSpeed", DoubleValue(m_config.patrolSpeed + drift));
+    }
+
+    // ----- Internet -----
+    // Always a routing list, so attack filters can be added above the protocol
+    Ipv4ListRoutingHelper routing;
+    routing.Add(Ipv4StaticRoutingHelper(), 0);
+
+    if (m_config.routing == "aodv")
+        routing.Add(AodvHelper(), 10);
+    else if (m_config.routing == "olsr")
+        routing.Add(OlsrHelper(), 10);
+    else if (m_config.routing == "dsdv")
+        routing.Add(DsdvHelper(), 10);
+    else
+        NS_ABORT_MSG_IF(m_config.routing != "none", "Unknown routing " << m_config.routing);
+
+    InternetStackHelper internet;
+    internet.SetRoutingHelper(routing);
+    internet.Install(m_nodes);
+
+    // The address generator outlives Simulator::Destroy(); start each run clean
+    Ipv4AddressGenerator::Reset();
+
+    // /24 per scenario, widened to /16 for swarms that do not fit
+    Ipv4Mask mask(m_nodes.GetN() < 254 ? "255.255.255.0" : "255.255.0.0");
+    NS_ABORT_MSG_IF(m_nodes.GetN() >= 65534, "Too many nodes for one subnet");
+
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase(Ipv4Address(m_config.subnet.c_str()).CombineMask(mask), mask);
+    ipv4.Assign(m_devices);
+}
+
+inline void
+SwarmScenario::BuildTraffic()
+{
+    Ipv4Address leaderAddress = m_leader->GetObject<Ipv4>()->GetAddress(1, 0).GetLocal();
+    Time interval = Seconds(m_config.heartbeatInterval);
+
+    if (m_config.traffic == "flat")
+    {
+        // ----- Heartbeat traffic -----
+        UdpEchoServerHelper server(9);
+        server.Install(m_leader).Start(Seconds(1.0));
+
+        UdpEchoClientHelper client(leaderAddress, 9);
+
+        client.SetAttribute("Interval", TimeValue(interval));
+        client.SetAttribute("PacketSize", UintegerValue(m_config.payloadSize));
+
+        for (uint32_t i = 0; i < m_followers.GetN(); ++i)
+            client.Install(m_followers.Get(i)).Start(Seconds(2.0));
+        return;
+    }
+
+    if (m_config.traffic == "mission")
+    {
+        MissionTrafficProfile profile;
+        profile.telemetrySize = m_config.payloadSize;
+        profile.telemetryInterval = m_config.heartbeatInterval;
+        profile.sensorBurst = m_config.sensorBurst;
+        profile.videoSources = m_config.videoSources;
+        profile.videoRateKbps = m_config.videoRateKbps;
+        InstallMissionTraffic(m_leader, m_followers, profile, &m_mission, Seconds(2.0),
+                              Seconds(m_config.simTime - GetMaxMissionDeadline()));
+        return;
+    }
+
+    NS_ABORT_MSG_IF(m_config.traffic != "cluster", "Unknown traffic " << m_config.traffic);
+
+    // ----- Aggregated heartbeats: members -> head -> leader -----
+    m_sink = CreateObject<AggregateSink>();
+    m_leader->AddApplication(m_sink);
+    m_sink->SetStartTime(Seconds(1.0));
+
+    // Units are formed on the tight formation installed by BuildMobility()
+    std::vector<Vector> offsets;
+    for (uint32_t i = 0; i < m_followers.GetN(); ++i)
+        offsets.push_back(m_formation.GetOffset(i));
+    ClusterPlan plan = AssignClusters(offsets, m_config.clusterSize);
+
+    for (uint32_t head : plan.heads)
+    {
+        Ptr<ClusterHeadAggregator> app = CreateObject<ClusterHeadAggregator>();
+        app->SetAttribute("Remote", AddressValue(InetSocketAddress(leaderAddress, 9)));
+        app->SetAttribute("Interval", TimeValue(interval));
+        m_followers.Get(head)->AddApplication(app);
+        app->SetStartTime(Seconds(2.0));
+        m_heads.push_back(app);
+    }
+
+    for (uint32_t i = 0; i < m_followers.GetN(); ++i)
+    {
+        if (plan.headOf[i] == i)
+            continue;
+
+        Ptr<Node> head = m_followers.Get(plan.headOf[i]);
+        UdpClientHelper client(head->GetObject<Ipv4>()->GetAddress(1, 0).GetLocal(), 10);
+        client.SetAttribute("Interval", TimeValue(interval));
+        client.SetAttribute("PacketSize", UintegerValue(m_config.payloadSize));
+        client.Install(m_followers.Get(i)).Start(Seconds(2.0));
+    }
+
+    std::cout << "[INFO] Cluster traffic: " << plan.heads.size() << " heads for "
+              << m_followers.GetN() << " followers (clusterSize " << m_config.clusterSize
+              << ")\n";
+}
+
+inline void
+SwarmScenario::PrintHeartbeats(Ptr<FlowMonitor> monitor,
+                               Ptr<Ipv4FlowClassifier> classifier) const
+{
+    Ipv4Address leaderAddress = m_leader->GetObject<Ipv4>()->GetAddress(1, 0).GetLocal();
+
+    double generated = 0;
+    double delivered = 0;
+    double age = 0;
+    double leaderPackets = 0;
+
+    if (!m_sink)
+    {
+        // Flat: every heartbeat is its own flow into the leader
+        FlowMetrics hb = ComputeFlowMetrics(monitor, classifier,
+            [leaderAddress](const Ipv4FlowClassifier::FiveTuple &t) {
+                return t.destinationAddress == leaderAddress && t.destinationPort == 9;
+            });
+        generated = hb.txPackets;
+        delivered = hb.rxPackets;
+        age = hb.AvgDelay();
+        leaderPackets = hb.rxPackets;
+    }
+    else
+    {
+        // Cluster: member heartbeats go to heads; heads add their own
+        FlowMetrics members = ComputeFlowMetrics(monitor, classifier,
+            [](const Ipv4FlowClassifier::FiveTuple &t) { return t.destinationPort == 10; });
+        generated = members.txPackets;
+        for (const auto &head : m_heads)
+            generated += head->GetOwnHeartbeats();
+        delivered = m_sink->GetHeartbeats();
+        age = m_sink->GetMeanAge();
+        leaderPackets = m_sink->GetAggregates();
+    }
+
+    std::cout << "\n===== HEARTBEATS (" << m_config.traffic << ") =====\n";
+    std::cout << "Generated: " << generated << "\n";
+    std::cout << "Delivered to leader: " << delivered << "\n";
+    std::cout << "Delivery ratio: " << (generated > 0 ? 100.0 * delivered / generated : 0.0)
+              << " %\n";
+    std::cout << "Mean heartbeat age at leader: " << age << " s\n";
+    std::cout << "Heartbeat packets into leader: " << leaderPackets << "\n";
+    std::cout << "=============================\n";
+}
+
+inline void
+SwarmScenario::Build()
+{
+    const SwarmScenarioConfig &c = m_config;
+    NS_ABORT_MSG_IF(c.nNodes < 2, "A swarm needs a leader and at least one follower");
+
+    if (c.rngRun > 0)
+        RngSeedManager::SetRun(c.rngRun);
+
+    // The profiler wraps the chosen scheduler rather than replacing it
+    if (!c.profile.empty())
+        m_profiler.Enable(GetSchedulerTypeName(c.scheduler));
+    else
+        ConfigureScheduler(c.scheduler);
+
+    m_nodes.Create(c.nNodes);
+    m_leader = m_nodes.Get(0);
+    for (uint32_t i = 1; i < c.nNodes; ++i)
+        m_followers.Add(m_nodes.Get(i));
+
+    BuildMobility();
+    BuildNetwork();
+    BuildTraffic();
+}
+
+inline void
+SwarmScenario::Instrument()
+{
+    const SwarmScenarioConfig &c = m_config;
+
+    // ----- Attack detection -----
+    WatchdogDetector::Params watchdogParams;
+    watchdogParams.window = Seconds(c.watchdogWindow);
+    watchdogParams.threshold = c.watchdogThreshold;
+    m_watchdog.reset(new WatchdogDetector(watchdogParams));
+    if (c.watchdog || c.mitigation)
+        m_watchdog->Install(m_nodes);
+    if (c.mitigation)
+        m_mitigation.Install(m_nodes, *m_watchdog);
+
+    // ----- Routing control overhead -----
+    if (c.routingStats)
+    {
+        m_routingMonitor.reset(new RoutingOverheadMonitor(c.routing));
+        m_routingMonitor->Install();
+    }
+
+    // ----- Airtime, collisions and leader load -----
+    if (c.channelStats)
+    {
+        m_channelLoad.reset(new ChannelLoadMonitor(m_leader));
+        m_channelLoad->Install();
+    }
+
+    // ----- Windowed metrics around the attack time -----
+    m_windowed.reset(new WindowedMetrics(Seconds(c.window), Seconds(c.attackTime)));
+    m_windowed->SetOutput(c.name + "_swarm_windows.csv");
+    m_windowed->Install();
+
+    m_flowMonitor = m_flowHelper.InstallAll();
+    m_classifier = DynamicCast<Ipv4FlowClassifier>(m_flowHelper.GetClassifier());
+
+    // Per-flow records streamed during the run
+    m_flowStream.reset(new FlowStatsStreamWriter(m_flowMonitor, m_classifier,
+                                                 c.name + "_swarm_flows.csv",
+                                                 Seconds(c.statsInterval)));
+    m_flowStream->Start();
+
+    // ----- Radio energy -----
+    if (c.energy)
+    {
+        EnergyAccounting::Params energyParams;
+        energyParams.initialEnergy = c.initialEnergy;
+        energyParams.sampleInterval = Seconds(c.energySampleInterval);
+        m_energy.reset(new EnergyAccounting(energyParams));
+        m_energy->Install(m_nodes, m_devices);
+        m_energy->SetOutput(c.name + "_swarm_energy.csv");
+
+        // Formation phases (see BuildMobility) and the attack split
+        Time end = Seconds(c.simTime);
+        m_energy->AddSegment("tight", Seconds(0), Min(Seconds(30.0), end));
+        if (c.simTime > 30.0)
+            m_energy->AddSegment("wide", Seconds(30.0), Min(Seconds(60.0), end));
+        if (c.simTime > 60.0)
+            m_energy->AddSegment("tight again", Seconds(60.0), end);
+        m_energy->AddSegment("pre-attack", Seconds(0), Seconds(c.attackTime));
+        m_energy->AddSegment("post-attack", Seconds(c.attackTime), end);
+    }
+}
+
+inline FlowMetrics
+SwarmScenario::Run()
+{
+    const SwarmScenarioConfig &c = m_config;
+
+    Build();
+
+    // ----- Attack mid-patrol -----
+    m_attack->Install(m_nodes);
+    Simulator::Schedule(Seconds(c.attackTime), &AttackModel::Activate, m_attack);
+
+    Instrument();
+    Simulator::Stop(Seconds(c.simTime));
+
+    m_profiler.BeginPhase("run");
+    Simulator::Run();
+    m_profiler.CaptureRun();
+
+    return Report();
+}
+
+inline void
+SwarmScenario::RunPrefix()
+{
+    Build();
+    Instrument();
+    Simulator::Stop(Seconds(m_config.attackTime));
+
+    m_profiler.BeginPhase("run");
+    Simulator::Run();
+    m_profiler.EndPhase();
+
+    // Nothing may sit in a buffer that every child would write out again
+    m_flowStream->Flush();
+    m_windowed->Flush();
+}
+
+inline FlowMetrics
+SwarmScenario::ContinueAs(const SwarmScenarioConfig &variant)
+{
+    m_config = variant;
+    const SwarmScenarioConfig &c = m_config;
+
+    m_flowStream->ContinueAs(c.name + "_swarm_flows.csv");
+    m_windowed->ContinueAs(c.name + "_swarm_windows.csv");
+    if (m_energy)
+        m_energy->SetOutput(c.name + "_swarm_energy.csv");
+
+    // The prefix stopped at attackTime, so the attack starts right now
+    m_attack = CreateAttackModel(c);
+    m_attack->Install(m_nodes);
+    m_attack->Activate();
+
+    Simulator::Stop(Seconds(c.simTime) - Simulator::Now());
+
+    m_profiler.BeginPhase("run");
+    Simulator::Run();
+    m_profiler.CaptureRun();
+
+    return Report();
+}
+
+inline void
+SwarmScenario::Discard()
+{
+    m_flowStream.reset();
+    m_windowed.reset();
+    Simulator::Destroy();
+
+    std::remove((m_config.name + "_swarm_flows.csv").c_str());
+    std::remove((m_config.name + "_swarm_windows.csv").c_str());
+}
+
+inline FlowMetrics
+SwarmScenario::Report()
+{
+    const SwarmScenarioConfig &c = m_config;
+
+    m_profiler.BeginPhase("metrics");
+    m_flowMonitor->CheckForLostPackets();
+    m_flowStream->Finish();
+    m_windowed->Finish();
+
+    FlowMetrics metrics = ComputeFlowMetrics(m_flowMonitor, m_classifier);
+
+    std::string title = c.name;
+    std::transform(title.begin(), title.end(), title.begin(), ::toupper);
+    PrintFlowMetrics("SWARM " + title + " METRICS", metrics);
+
+    m_windowed->PrintSummary();
+    if (m_routingMonitor)
+        m_routingMonitor->PrintSummary();
+    if (c.traffic == "mission")
+        m_mission.PrintSummary(Seconds(c.simTime - GetMaxMissionDeadline() - 2.0));
+    else
+        PrintHeartbeats(m_flowMonitor, m_classifier);
+    if (m_channelLoad)
+        m_channelLoad->PrintSummary(Seconds(c.simTime));
+    m_attack->PrintSummary();
+
+    if (c.watchdog || c.mitigation)
+    {
+        m_watchdog->Finish();
+        m_watchdog->PrintSummary(c.attack == "none" ? -1 : int32_t(c.maliciousNodeId),
+                                 Seconds(c.attackTime), Seconds(c.detectionDeadline));
+    }
+    if (c.mitigation)
+        m_mitigation.PrintSummary(Seconds(c.attackTime));
+    if (m_energy)
+    {
+        m_energy->Finish();
+        m_energy->PrintSummary();
+        m_joulesPerBit = m_energy->GetJoulesPerBit();
+    }
+
+    m_recoveryTime = m_windowed->GetRecoveryTime();
+    if (m_routingMonitor)
+        m_controlPackets = m_routingMonitor->GetControlPackets();
+    if (m_channelLoad)
+    {
+        m_txAirtime = m_channelLoad->GetTxAirtime().GetSeconds();
+        m_rxErrors = m_channelLoad->GetRxErrors();
+        m_leaderRxPackets = m_channelLoad->GetSinkPacketsReceived();
+    }
+
+    if (c.xmlOutput)
+    {
+        m_profiler.BeginPhase("xml");
+        m_flowMonitor->SerializeToXmlFile(
+            c.name + "_swarm.xml",
+            true,   // enable histograms
+            true    // enable probes
+        );
+    }
+    m_profiler.EndPhase();
+
+    PrintGridChannelStats(m_gridChannel);
+    PrintLossCacheStats(m_lossCache);
+
+    m_profiler.SetLabel("scenario", c.name);
+    m_profiler.SetLabel("attack", c.attack);
+    m_profiler.SetLabel("routing", c.routing);
+    m_profiler.SetLabel("channelMode", c.channelMode);
+    m_profiler.SetLabel("scheduler", c.scheduler);
+    m_profiler.SetLabel("nNodes", c.nNodes);
+    m_profiler.SetLabel("simTime", c.simTime);
+    m_profiler.SetLabel("formationScale", c.formationScale);
+    m_profiler.SetLabel("heartbeatInterval", c.heartbeatInterval);
+    m_profiler.SetLabel("traffic", c.traffic);
+    m_profiler.SetLabel("wifiStandard", c.wifiStandard);
+    m_profiler.SetLabel("rateControl", c.rateControl);
+    m_profiler.SetLabel("payloadSize", c.payloadSize);
+    m_profiler.SetLabel("energy", c.energy ? 1.0 : 0.0);
+    m_profiler.SetLabel("pdr", metrics.Pdr());
+    m_profiler.SetLabel("avgDelay", metrics.AvgDelay());
+    m_profiler.SetLabel("throughputKbps", metrics.ThroughputKbps());
+    m_profiler.Print();
+    m_profiler.Write(c.profile);
+
+    Simulator::Destroy();
+    return metrics;
+}
+
+} // namespace ns3
+
+#endif /* SWARM_SCENARIO_H */
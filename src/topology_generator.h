@@ -0,0 +1,562 @@
+#ifndef TOPOLOGY_GENERATOR_H
+#define TOPOLOGY_GENERATOR_H
+
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/*
+ Random static topologies
+ - Layouts:
+     rgg       random geometric graph, uniform in a square sized so the
+               mean degree is about MeanDegree at the given range
+     grid      square lattice (spacing < range) with a little jitter
+     corridor  uniform in a strip one range wide, long enough for the
+               same mean degree: long multi-hop paths, like a road or a
+               tunnel
+ - Neighbors are nodes within range, found through a spatial hash of
+   range-sized cells (3x3 cells per node), so generation is O(N) for a
+   fixed density
+ - A random layout is redrawn up to Attempts times until connected.
+   After that, the smaller components are joined to the largest one,
+   nearest first: each is shifted as a whole until its node closest to
+   the connected part is half a range away from it. Shapes inside a
+   component are kept; a corridor with gaps gets shorter and bends a
+   little at each join. GetRepaired() says how many nodes moved. The
+   connected part is kept in its own spatial hash and each join searches
+   it in growing rings of cells around the component, so a join costs
+   the cells between the component and the connected part, not a scan
+   of every joined node
+ - Centrality picks the attacker: degree (free) or betweenness, exact
+   or estimated from sampled BFS sources (Brandes, O(samples x edges))
+ - Range is a unit-disc approximation of the radio; keep it a little
+   below the PHY's real reach so that neighbors here hear each other
+   (about 110 m for 802.11b at 1 Mbps on the default Yans channel)
+*/
+class TopologyGenerator
+{
+  public:
+    struct Params
+    {
+        std::string layout = "rgg";     // rgg, grid or corridor
+        double range = 100.0;           // m, neighbors are closer than this
+        double meanDegree = 10.0;       // rgg/corridor: sets the node density
+        double spacing = 0.0;           // grid: lattice spacing, 0 = 0.7 x range
+        double jitter = 0.1;            // grid: noise, fraction of the spacing
+        uint32_t attempts = 5;          // rgg/corridor draws before repairing
+    };
+
+    explicit TopologyGenerator(const Params &params);
+
+    void Generate(uint32_t nNodes);
+
+    uint32_t GetN() const { return m_positions.size(); }
+    const Vector &GetPosition(uint32_t node) const { return m_positions[node]; }
+    const std::vector<uint32_t> &GetNeighbors(uint32_t node) const { return m_neighbors[node]; }
+    Ptr<ListPositionAllocator> GetPositionAllocator() const;
+
+    double GetMeanDegree() const;
+    uint32_t GetRepaired() const { return m_repaired; }
+    uint32_t GetDraws() const { return m_draws; }
+    bool IsConnected() const;
+
+    // BFS hop counts, UINT32_MAX where unreachable
+    std::vector<uint32_t> HopDistances(uint32_t source) const;
+    uint32_t FarthestFrom(uint32_t node) const;
+
+    // Score per node: "degree" or "betweenness" (samples = 0 or >= N is exact)
+    std::vector<double> Centrality(const std::string &method, uint32_t samples) const;
+
+    // Highest score outside exclude
+    static uint32_t MostCentral(const std::vector<double> &scores,
+                                const std::set<uint32_t> &exclude);
+
+    void PrintSummary() const;
+
+  private:
+    typedef uint64_t CellKey;
+
+    CellKey KeyOf(int64_t cx, int64_t cy) const
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) |
+               static_cast<uint32_t>(cy);
+    }
+    int64_t CellOf(double coordinate) const
+    {
+        return static_cast<int64_t>(std::floor(coordinate / m_params.range));
+    }
+
+    void Place(uint32_t nNodes);
+    void BuildNeighbors();
+    // Connected components, largest first
+    std::vector<std::vector<uint32_t>> Components() const;
+    void Repair();
+    std::vector<double> Betweenness(uint32_t samples) const;
+
+    Params m_params;
+    Ptr<UniformRandomVariable> m_rand;
+
+    std::vector<Vector> m_positions;
+    std::vector<std::vector<uint32_t>> m_neighbors;
+    uint32_t m_draws = 0;
+    uint32_t m_repaired = 0;
+};
+
+inline
+TopologyGenerator::TopologyGenerator(const Params &params)
+    : m_params(params),
+      m_rand(CreateObject<UniformRandomVariable>())
+{
+    NS_ABORT_MSG_IF(m_params.layout != "rgg" && m_params.layout != "grid" &&
+                        m_params.layout != "corridor",
+                    "Unknown layout " << m_params.layout << " (rgg, grid or corridor)");
+    NS_ABORT_MSG_IF(m_params.range <= 0.0, "The range must be positive");
+    NS_ABORT_MSG_IF(m_params.meanDegree <= 0.0, "The mean degree must be positive");
+    if (m_params.spacing <= 0.0)
+        m_params.spacing = 0.7 * m_params.range;
+}
+
+inline void
+TopologyGenerator::Generate(uint32_t nNodes)
+{
+    NS_ABORT_MSG_IF(nNodes < 2, "A topology needs at least two nodes");
+
+    m_draws = 0;
+    m_repaired = 0;
+    uint32_t attempts = m_params.layout == "grid" ? 1 : std::max(m_params.attempts, 1u);
+    do
+    {
+        Place(nNodes);
+        BuildNeighbors();
+        ++m_draws;
+    } while (!IsConnected() && m_draws < attempts);
+
+    if (!IsConnected())
+        Repair();
+}
+
+inline void
+TopologyGenerator::Place(uint32_t nNodes)
+{
+    const double r = m_params.range;
+    m_positions.resize(nNodes);
+
+    if (m_params.layout == "grid")
+    {
+        uint32_t columns = std::ceil(std::sqrt(nNodes));
+        double s = m_params.spacing;
+        double noise = m_params.jitter * s;
+        for (uint32_t i = 0; i < nNodes; ++i)
+        {
+            m_positions[i] = Vector((i % columns) * s + m_rand->GetValue(-noise, noise),
+                                    (i / columns) * s + m_rand->GetValue(-noise, noise), 0.0);
+        }
+        return;
+    }
+
+    double width;
+    double height;
+    if (m_params.layout == "corridor")
+    {
+        // A disc of radius r clipped to a strip r wide covers about 2r x r
+        height = r;
+        width = 2.0 * r * nNodes / m_params.meanDegree;
+    }
+    else
+    {
+        width = height = std::sqrt(nNodes * M_PI * r * r / m_params.meanDegree);
+    }
+
+    for (uint32_t i = 0; i < nNodes; ++i)
+        m_positions[i] = Vector(m_rand->GetValue(0.0, width), m_rand->GetValue(0.0, height), 0.0);
+}
+
+inline void
+TopologyGenerator::BuildNeighbors()
+{
+    std::unordered_map<CellKey, std::vector<uint32_t>> grid;
+    grid.reserve(m_positions.size());
+    for (uint32_t i = 0; i < m_positions.size(); ++i)
+        grid[KeyOf(CellOf(m_positions[i].x), CellOf(m_positions[i].y))].push_back(i);
+
+    const double r2 = m_params.range * m_params.range;
+    m_neighbors.assign(m_positions.size(), {});
+    for (uint32_t i = 0; i < m_positions.size(); ++i)
+    {
+        const Vector &p = m_positions[i];
+        int64_t cx = CellOf(p.x);
+        int64_t cy = CellOf(p.y);
+        for (int64_t dx = -1; dx <= 1; ++dx)
+        {
+            for (int64_t dy = -1; dy <= 1; ++dy)
+            {
+                auto cell = grid.find(KeyOf(cx + dx, cy + dy));
+                if (cell == grid.end())
+                    continue;
+                for (uint32_t j : cell->second)
+                {
+                    double ddx = m_positions[j].x - p.x;
+                    double ddy = m_positions[j].y - p.y;
+                    if (j != i && ddx * ddx + ddy * ddy < r2)
+                        m_neighbors[i].push_back(j);
+                }
+            }
+        }
+    }
+}
+
+inline std::vector<uint32_t>
+TopologyGenerator::HopDistances(uint32_t source) const
+{
+    const uint32_t unreached = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> hops(m_positions.size(), unreached);
+    std::vector<uint32_t> queue;
+    queue.reserve(m_positions.size());
+
+    hops[source] = 0;
+    queue.push_back(source);
+    for (uint32_t head = 0; head < queue.size(); ++head)
+    {
+        uint32_t v = queue[head];
+        for (uint32_t w : m_neighbors[v])
+        {
+            if (hops[w] == unreached)
+            {
+                hops[w] = hops[v] + 1;
+                queue.push_back(w);
+            }
+        }
+    }
+    return hops;
+}
+
+inline uint32_t
+TopologyGenerator::FarthestFrom(uint32_t node) const
+{
+    std::vector<uint32_t> hops = HopDistances(node);
+    uint32_t farthest = node;
+    for (uint32_t i = 0; i < hops.size(); ++i)
+    {
+        if (hops[i] != std::numeric_limits<uint32_t>::max() && hops[i] > hops[farthest])
+            farthest = i;
+    }
+    return farthest;
+}
+
+inline bool
+TopologyGenerator::IsConnected() const
+{
+    if (m_positions.empty())
+        return true;
+    std::vector<uint32_t> hops = HopDistances(0);
+    return std::find(hops.begin(), hops.end(), std::numeric_limits<uint32_t>::max()) == hops.end();
+}
+
+inline std::vector<std::vector<uint32_t>>
+TopologyGenerator::Components() const
+{
+    std::vector<bool> seen(m_positions.size(), false);
+    std::vector<std::vector<uint32_t>> components;
+
+    for (uint32_t start = 0; start < m_positions.size(); ++start)
+    {
+        if (seen[start])
+            continue;
+
+        std::vector<uint32_t> members{start};
+        seen[start] = true;
+        for (uint32_t head = 0; head < members.size(); ++head)
+        {
+            for (uint32_t w : m_neighbors[members[head]])
+            {
+                if (!seen[w])
+                {
+                    seen[w] = true;
+                    members.push_back(w);
+                }
+            }
+        }
+        components.push_back(std::move(members));
+    }
+
+    std::sort(components.begin(), components.end(),
+              [](const std::vector<uint32_t> &a, const std::vector<uint32_t> &b) {
+                  return a.size() > b.size();
+              });
+    return components;
+}
+
+inline void
+TopologyGenerator::Repair()
+{
+    std::vector<std::vector<uint32_t>> components = Components();
+    std::vector<uint32_t> joined = components[0];
+
+    auto centroid = [this](const std::vector<uint32_t> &members) {
+        Vector c;
+        for (uint32_t i : members)
+        {
+            c.x += m_positions[i].x / members.size();
+            c.y += m_positions[i].y / members.size();
+        }
+        return c;
+    };
+    auto distance2 = [](const Vector &a, const Vector &b) {
+        return (a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y);
+    };
+
+    // Nearest first, so a chain of components (a corridor's gaps) closes up in order
+    Vector center = centroid(joined);
+    std::vector<std::pair<double, uint32_t>> order;
+    for (uint32_t k = 1; k < components.size(); ++k)
+        order.push_back({distance2(centroid(components[k]), center), k});
+    std::sort(order.begin(), order.end());
+
+    // Joined nodes by cell, for the nearest-anchor search
+    std::unordered_map<CellKey, std::vector<uint32_t>> grid;
+    int64_t minX = std::numeric_limits<int64_t>::max();
+    int64_t maxX = std::numeric_limits<int64_t>::min();
+    int64_t minY = minX;
+    int64_t maxY = maxX;
+    auto insert = [&](uint32_t i) {
+        int64_t cx = CellOf(m_positions[i].x);
+        int64_t cy = CellOf(m_positions[i].y);
+        grid[KeyOf(cx, cy)].push_back(i);
+        minX = std::min(minX, cx);
+        maxX = std::max(maxX, cx);
+        minY = std::min(minY, cy);
+        maxY = std::max(maxY, cy);
+    };
+    for (uint32_t j : joined)
+        insert(j);
+
+    // Closest joined node to c: rings of cells around c's cell until no
+    // unvisited cell can hold anything closer, or the rings cover all
+    // joined cells
+    auto nearestJoined = [&](const Vector &c) {
+        int64_t cx = CellOf(c.x);
+        int64_t cy = CellOf(c.y);
+        int64_t last = std::max({cx - minX, maxX - cx, cy - minY, maxY - cy, int64_t(0)});
+        uint32_t best = joined[0];
+        double bestD2 = std::numeric_limits<double>::max();
+        for (int64_t ring = 0; ring <= last; ++ring)
+        {
+            for (int64_t x = cx - ring; x <= cx + ring; ++x)
+            {
+                // Edges of the ring only: full rows top and bottom, two cells between
+                int64_t step = (x == cx - ring || x == cx + ring) ? 1 : std::max<int64_t>(2 * ring, 1);
+                for (int64_t y = cy - ring; y <= cy + ring; y += step)
+                {
+                    auto cell = grid.find(KeyOf(x, y));
+                    if (cell == grid.end())
+                        continue;
+                    for (uint32_t j : cell->second)
+                    {
+                        double d2 = distance2(m_positions[j], c);
+                        if (d2 < bestD2)
+                        {
+                            bestD2 = d2;
+                            best = j;
+                        }
+                    }
+                }
+            }
+            // Cells of the next ring are at least ring ranges from c
+            double reach = ring * m_params.range;
+            if (bestD2 <= reach * reach)
+                break;
+        }
+        return best;
+    };
+
+    for (const auto &entry : order)
+    {
+        const std::vector<uint32_t> &members = components[entry.second];
+
+        // Closest joined node to the component, then its member closest to that
+        Vector c = centroid(members);
+        uint32_t anchor = nearestJoined(c);
+        uint32_t near = members[0];
+        for (uint32_t i : members)
+        {
+            if (distance2(m_positions[i], m_positions[anchor]) <
+                distance2(m_positions[near], m_positions[anchor]))
+                near = i;
+        }
+
+        // Shift so that near sits half a range from anchor, same bearing
+        const Vector &a = m_positions[anchor];
+        const Vector &b = m_positions[near];
+        double length = std::sqrt(distance2(a, b));
+        double ux = length > 0.0 ? (b.x - a.x) / length : 1.0;
+        double uy = length > 0.0 ? (b.y - a.y) / length : 0.0;
+        double dx = a.x + 0.5 * m_params.range * ux - b.x;
+        double dy = a.y + 0.5 * m_params.range * uy - b.y;
+
+        for (uint32_t i : members)
+        {
+            m_positions[i].x += dx;
+            m_positions[i].y += dy;
+            joined.push_back(i);
+            insert(i);
+        }
+        m_repaired += members.size();
+    }
+    BuildNeighbors();
+}
+
+inline double
+TopologyGenerator::GetMeanDegree() const
+{
+    uint64_t edges = 0;
+    for (const auto &neighbors : m_neighbors)
+        edges += neighbors.size();
+    return m_positions.empty() ? 0.0 : double(edges) / m_positions.size();
+}
+
+inline Ptr<ListPositionAllocator>
+TopologyGenerator::GetPositionAllocator() const
+{
+    Ptr<ListPositionAllocator> allocator = CreateObject<ListPositionAllocator>();
+    for (const Vector &p : m_positions)
+        allocator->Add(p);
+    return allocator;
+}
+
+inline std::vector<double>
+TopologyGenerator::Centrality(const std::string &method, uint32_t samples) const
+{
+    if (method == "betweenness")
+        return Betweenness(samples);
+
+    NS_ABORT_MSG_IF(method != "degree",
+                    "Unknown centrality " << method << " (degree or betweenness)");
+    std::vector<double> scores(m_positions.size());
+    for (uint32_t i = 0; i < scores.size(); ++i)
+        scores[i] = m_neighbors[i].size();
+    return scores;
+}
+
+inline std::vector<double>
+TopologyGenerator::Betweenness(uint32_t samples) const
+{
+    const uint32_t n = m_positions.size();
+    const uint32_t unreached = std::numeric_limits<uint32_t>::max();
+
+    // Sources: everyone, or the first samples of a random permutation
+    std::vector<uint32_t> sources(n);
+    for (uint32_t i = 0; i < n; ++i)
+        sources[i] = i;
+    if (samples > 0 && samples < n)
+    {
+        for (uint32_t i = 0; i < samples; ++i)
+            std::swap(sources[i], sources[m_rand->GetInteger(i, n - 1)]);
+        sources.resize(samples);
+    }
+
+    std::vector<double> score(n, 0.0);
+    std::vector<uint32_t> hops(n);
+    std::vector<double> paths(n);
+    std::vector<double> dependency(n);
+    std::vector<uint32_t> order;
+    order.reserve(n);
+
+    for (uint32_t s : sources)
+    {
+        std::fill(hops.begin(), hops.end(), unreached);
+        std::fill(paths.begin(), paths.end(), 0.0);
+        std::fill(dependency.begin(), dependency.end(), 0.0);
+        order.clear();
+
+        hops[s] = 0;
+        paths[s] = 1.0;
+        order.push_back(s);
+        for (uint32_t head = 0; head < order.size(); ++head)
+        {
+            uint32_t v = order[head];
+            for (uint32_t w : m_neighbors[v])
+            {
+                if (hops[w] == unreached)
+                {
+                    hops[w] = hops[v] + 1;
+                    order.push_back(w);
+                }
+                if (hops[w] == hops[v] + 1)
+                    paths[w] += paths[v];
+            }
+        }
+
+        // Predecessors are the neighbors one hop closer, no lists needed
+        for (uint32_t k = order.size(); k-- > 1;)
+        {
+            uint32_t w = order[k];
+            for (uint32_t v : m_neighbors[w])
+            {
+                if (hops[v] + 1 == hops[w])
+                    dependency[v] += paths[v] / paths[w] * (1.0 + dependency[w]);
+            }
+            score[w] += dependency[w];
+        }
+    }
+
+    double scale = double(n) / sources.size();
+    for (double &value : score)
+        value *= scale;
+    return score;
+}
+
+inline uint32_t
+TopologyGenerator::MostCentral(const std::vector<double> &scores,
+                               const std::set<uint32_t> &exclude)
+{
+    uint32_t best = std::numeric_limits<uint32_t>::max();
+    for (uint32_t i = 0; i < scores.size(); ++i)
+    {
+        if (exclude.count(i))
+            continue;
+        if (best == std::numeric_limits<uint32_t>::max() || scores[i] > scores[best])
+            best = i;
+    }
+    NS_ABORT_MSG_IF(best == std::numeric_limits<uint32_t>::max(), "No node left to choose");
+    return best;
+}
+
+inline void
+TopologyGenerator::PrintSummary() const
+{
+    // Bounding box, repaired components included
+    double minX = std::numeric_limits<double>::max();
+    double minY = minX;
+    double maxX = std::numeric_limits<double>::lowest();
+    double maxY = maxX;
+    for (const Vector &p : m_positions)
+    {
+        minX = std::min(minX, p.x);
+        minY = std::min(minY, p.y);
+        maxX = std::max(maxX, p.x);
+        maxY = std::max(maxY, p.y);
+    }
+
+    std::cout << "\n===== TOPOLOGY =====\n";
+    std::cout << "Layout: " << m_params.layout << ", " << GetN() << " nodes in "
+              << maxX - minX << " x " << maxY - minY << " m\n";
+    std::cout << "Range: " << m_params.range << " m, mean degree " << GetMeanDegree() << "\n";
+    std::cout << "Draws: " << m_draws << ", repaired nodes: " << m_repaired << "\n";
+    std::cout << "Connected: " << (IsConnected() ? "yes" : "no") << "\n";
+    std::cout << "====================\n";
+}
+
+} // namespace ns3
+
+#endif /* TOPOLOGY_GENERATOR_H */
@@ -0,0 +1,455 @@
+#ifndef WATCHDOG_DETECTOR_H
+#define WATCHDOG_DETECTOR_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/*
+ Watchdog forwarding monitor (one per node)
+ - When a node hands a unicast IPv4 frame to a next hop that is not the
+   packet's destination (MonitorSnifferTx), it expects to overhear that
+   neighbor retransmit the same packet (same IP source, destination and
+   identification) within Timeout (MonitorSnifferRx). Otherwise the
+   neighbor is charged with a drop
+ - Per-neighbor evidence lives in a fixed table of NEIGHBORS slots:
+   exponentially decayed counts (time constant Window) of packets handed
+   over and packets seen forwarded. A neighbor is flagged once it has
+   MinEvidence handed over and forwards less than Threshold of them
+ - Outstanding expectations sit in a fixed ring of PENDING entries,
+   oldest first; confirmed ones are marked settled in place and every
+   entry leaves from the head, lazily on the node's next frame, so the
+   detector schedules no events and allocates nothing per packet. A
+   drop is charged (and a flag timestamped) when it is noticed there
+ - Frames are parsed from a stack copy: 802.11 data header (QoS and
+   A-MPDU delimiter aware), LLC/SNAP, then the IPv4 header
+ - CPU cost is the wall time spent in the two sniffer callbacks
+*/
+class WatchdogDetector
+{
+  public:
+    struct Params
+    {
+        Time timeout = Seconds(1.0);   // to overhear the retransmission
+        Time window = Seconds(5.0);    // evidence decay time constant
+        double threshold = 0.75;       // flag below this forwarding ratio
+        double minEvidence = 5.0;      // decayed packets handed over
+    };
+
+    explicit WatchdogDetector(const Params &params) : m_params(params) {}
+
+    // Hook every node's Wi-Fi PHY; call after the devices and addresses exist
+    void Install(const NodeContainer &nodes);
+
+    // Expire what is still outstanding; call after Simulator::Run()
+    void Finish();
+
+    // Detection latency is measured from activation for the malicious
+    // node (a negative id means no attacker)
+    void PrintSummary(int32_t maliciousNode, Time activation, Time deadline) const;
+
+    // Called with (detecting node, flagged neighbor) the first time a
+    // node flags a neighbor; indices are positions in the installed nodes
+    void SetFlagCallback(Callback<void, uint32_t, uint32_t> callback) { m_flagCallback = callback; }
+
+    // MAC address bytes as a 48-bit integer
+    static uint64_t MacKey(const uint8_t *p);
+
+  private:
+    static const uint32_t NEIGHBORS = 32;
+    static const uint32_t PENDING = 64;
+    static const uint32_t SETTLED = ~0u;   // pending entry already confirmed
+
+    struct Neighbor
+    {
+        uint32_t node = ~0u;
+        bool flagged = false;
+        float handed = 0.0f;      // decayed counts
+        float forwarded = 0.0f;
+        double updated = 0.0;     // s
+    };
+
+    struct Pending
+    {
+        uint64_t signature;
+        uint32_t neighbor;
+        double deadline;          // s
+    };
+
+    struct Monitor
+    {
+        WatchdogDetector *detector;
+        uint32_t node;
+        std::array<Neighbor, NEIGHBORS> neighbors;
+        std::array<Pending, PENDING> ring;
+        uint32_t head = 0;
+        uint32_t size = 0;
+
+        void SnifferTx(Ptr<const Packet> packet, uint16_t channelFreqMhz, WifiTxVector txVector,
+                       MpduInfo aMpdu, uint16_t staId);
+        void SnifferRx(Ptr<const Packet> packet, uint16_t channelFreqMhz, WifiTxVector txVector,
+                       MpduInfo aMpdu, SignalNoiseDbm signalNoise, uint16_t staId);
+    };
+
+    struct Frame
+    {
+        uint64_t receiver;        // MAC addresses as 48-bit integers
+        uint64_t transmitter;
+        uint32_t ipDst;
+        uint64_t signature;
+    };
+
+    struct Flag
+    {
+        uint32_t detector;
+        uint32_t accused;
+        Time time;
+    };
+
+    // False if this is not a unicast IPv4 data frame
+    static bool Parse(Ptr<const Packet> packet, const MpduInfo &aMpdu, Frame &frame);
+
+    void Handed(Monitor &m, const Frame &frame);
+    void Overheard(Monitor &m, const Frame &frame);
+    void Expire(Monitor &m, double now);
+    Neighbor &Lookup(Monitor &m, uint32_t node);
+    void Update(Monitor &m, uint32_t node, bool forwarded, double now);
+
+    Params m_params;
+    std::vector<Monitor> m_monitors;
+    Neighbor m_spare;   // Lookup() result when a table holds only flagged neighbors
+    std::unordered_map<uint64_t, uint32_t> m_macToNode;   // built once in Install()
+    std::vector<uint32_t> m_nodeAddress;
+
+    std::vector<Flag> m_flags;
+    Callback<void, uint32_t, uint32_t> m_flagCallback;
+    uint64_t m_frames = 0;
+    uint64_t m_handed = 0;
+    uint64_t m_confirmed = 0;
+    uint64_t m_expired = 0;
+    uint64_t m_overflow = 0;
+    double m_cpuNs = 0.0;
+};
+
+inline uint64_t
+WatchdogDetector::MacKey(const uint8_t *p)
+{
+    uint64_t key = 0;
+    for (uint32_t i = 0; i < 6; ++i)
+        key = (key << 8) | p[i];
+    return key;
+}
+
+inline void
+WatchdogDetector::Install(const NodeContainer &nodes)
+{
+    m_monitors.resize(nodes.GetN());
+    m_nodeAddress.assign(nodes.GetN(), 0);
+
+    for (uint32_t i = 0; i < nodes.GetN(); ++i)
+    {
+        Ptr<Node> node = nodes.Get(i);
+        m_monitors[i].detector = this;
+        m_monitors[i].node = i;
+
+        Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+        if (ipv4 && ipv4->GetNInterfaces() > 1)
+            m_nodeAddress[i] = ipv4->GetAddress(1, 0).GetLocal().Get();
+
+        for (uint32_t d = 0; d < node->GetNDevices(); ++d)
+        {
+            Ptr<WifiNetDevice> dev = DynamicCast<WifiNetDevice>(node->GetDevice(d));
+            if (!dev)
+                continue;
+
+            uint8_t mac[6];
+            Mac48Address::ConvertFrom(dev->GetAddress()).CopyTo(mac);
+            m_macToNode[MacKey(mac)] = i;
+
+            dev->GetPhy()->TraceConnectWithoutContext(
+                "MonitorSnifferTx", MakeCallback(&Monitor::SnifferTx, &m_monitors[i]));
+            dev->GetPhy()->TraceConnectWithoutContext(
+                "MonitorSnifferRx", MakeCallback(&Monitor::SnifferRx, &m_monitors[i]));
+        }
+    }
+}
+
+inline bool
+WatchdogDetector::Parse(Ptr<const Packet> packet, const MpduInfo &aMpdu, Frame &frame)
+{
+    uint8_t buf[96];
+    uint32_t len = packet->CopyData(buf, sizeof(buf));
+
+    // A-MPDU subframes start with a 4-byte delimiter
+    uint32_t p = (aMpdu.type == NORMAL_MPDU) ? 0 : 4;
+    if (len < p + 24)
+        return false;
+
+    const uint8_t *mac = buf + p;
+    uint8_t type = (mac[0] >> 2) & 0x3;
+    uint8_t subtype = (mac[0] >> 4) & 0xf;
+    if (type != 2 || (subtype & 0x4))   // data frames carrying data only
+        return false;
+    if (mac[4] & 0x01)                  // group receiver: no next hop to watch
+        return false;
+
+    uint32_t header = 24;
+    if ((mac[1] & 0x03) == 0x03)        // ToDS and FromDS: fourth address
+        header += 6;
+    if (subtype & 0x8)                  // QoS control, then HT control if Order
+    {
+        header += 2;
+        if (mac[1] & 0x80)
+            header += 4;
+    }
+
+    // LLC/SNAP (8 bytes, EtherType last), then IPv4
+    const uint8_t *llc = mac + header;
+    const uint8_t *ip = llc + 8;
+    if (len < p + header + 8 + 20 || llc[6] != 0x08 || llc[7] != 0x00)
+        return false;
+
+    frame.receiver = MacKey(mac + 4);
+    frame.transmitter = MacKey(mac + 10);
+
+    uint32_t src = (uint32_t(ip[12]) << 24) | (ip[13] << 16) | (ip[14] << 8) | ip[15];
+    frame.ipDst = (uint32_t(ip[16]) << 24) | (ip[17] << 16) | (ip[18] << 8) | ip[19];
+    uint16_t id = (ip[4] << 8) | ip[5];
+    frame.signature = ((uint64_t(src) << 32) | frame.ipDst) ^ (uint64_t(id) * 0x9E3779B97F4A7C15ull);
+    return true;
+}
+
+inline void
+WatchdogDetector::Monitor::SnifferTx(Ptr<const Packet> packet, uint16_t, WifiTxVector,
+                                     MpduInfo aMpdu, uint16_t)
+{
+    auto start = std::chrono::steady_clock::now();
+    Frame frame;
+    if (Parse(packet, aMpdu, frame))
+        detector->Handed(*this, frame);
+    detector->m_cpuNs +=
+        std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    ++detector->m_frames;
+}
+
+inline void
+WatchdogDetector::Monitor::SnifferRx(Ptr<const Packet> packet, uint16_t, WifiTxVector,
+                                     MpduInfo aMpdu, SignalNoiseDbm, uint16_t)
+{
+    auto start = std::chrono::steady_clock::now();
+    Frame frame;
+    if (Parse(packet, aMpdu, frame))
+        detector->Overheard(*this, frame);
+    detector->m_cpuNs +=
+        std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    ++detector->m_frames;
+}
+
+inline void
+WatchdogDetector::Handed(Monitor &m, const Frame &frame)
+{
+    double now = Simulator::Now().GetSeconds();
+    Expire(m, now);
+
+    auto it = m_macToNode.find(frame.receiver);
+    if (it == m_macToNode.end())
+        return;
+    uint32_t next = it->second;
+
+    // The next hop is the destination: nothing to forward
+    if (m_nodeAddress[next] == frame.ipDst)
+        return;
+
+    // MAC retries repeat the frame; watch each packet once
+    for (uint32_t i = 0; i < m.size; ++i)
+    {
+        const Pending &p = m.ring[(m.head + i) % PENDING];
+        if (p.signature == frame.signature && p.neighbor == next)
+            return;
+    }
+
+    if (m.size == PENDING)
+    {
+        // Full: give up on the oldest without charging anyone
+        m.head = (m.head + 1) % PENDING;
+        --m.size;
+        ++m_overflow;
+    }
+    m.ring[(m.head + m.size) % PENDING] = {frame.signature, next, now + m_params.timeout.GetSeconds()};
+    ++m.size;
+    ++m_handed;
+}
+
+inline void
+WatchdogDetector::Overheard(Monitor &m, const Frame &frame)
+{
+    double now = Simulator::Now().GetSeconds();
+    Expire(m, now);
+    if (m.size == 0)
+        return;
+
+    auto it = m_macToNode.find(frame.transmitter);
+    if (it == m_macToNode.end())
+        return;
+    uint32_t sender = it->second;
+
+    for (uint32_t i = 0; i < m.size; ++i)
+    {
+        Pending &p = m.ring[(m.head + i) % PENDING];
+        if (p.neighbor != sender || p.signature != frame.signature)
+            continue;
+
+        Update(m, sender, true, now);
+        ++m_confirmed;
+
+        // Settled; the slot is reclaimed when it reaches the head
+        p.neighbor = SETTLED;
+        return;
+    }
+}
+
+inline void
+WatchdogDetector::Expire(Monitor &m, double now)
+{
+    // Deadlines grow with insertion order, so expired entries are at the head
+    while (m.size > 0 && m.ring[m.head].deadline <= now)
+    {
+        const Pending &p = m.ring[m.head];
+        if (p.neighbor != SETTLED)
+        {
+            // Charged when the node notices, not at the deadline, so the
+            // reported detection latency includes the lazy expiry delay
+            Update(m, p.neighbor, false, now);
+            ++m_expired;
+        }
+        m.head = (m.head + 1) % PENDING;
+        --m.size;
+    }
+}
+
+inline WatchdogDetector::Neighbor &
+WatchdogDetector::Lookup(Monitor &m, uint32_t node)
+{
+    // Direct-mapped by node id, linear probing; a full table evicts the
+    // unflagged slot with the least evidence. Flagged slots are kept, so
+    // a neighbor is flagged at most once per node
+    uint32_t slot = node % NEIGHBORS;
+    Neighbor *weakest = nullptr;
+    for (uint32_t i = 0; i < NEIGHBORS; ++i)
+    {
+        Neighbor &n = m.neighbors[(slot + i) % NEIGHBORS];
+        if (n.node == node)
+            return n;
+        if (n.node == ~0u)
+        {
+            n.node = node;
+            return n;
+        }
+        if (!n.flagged && (!weakest || n.handed < weakest->handed))
+            weakest = &n;
+    }
+    if (!weakest)
+        return m_spare;   // every slot flagged: evidence is discarded
+    *weakest = Neighbor();
+    weakest->node = node;
+    return *weakest;
+}
+
+inline void
+WatchdogDetector::Update(Monitor &m, uint32_t node, bool forwarded, double now)
+{
+    Neighbor &n = Lookup(m, node);
+    if (&n == &m_spare)
+        return;
+
+    float decay = (now > n.updated) ? std::exp(-(now - n.updated) / m_params.window.GetSeconds())
+                                    : 1.0f;
+    n.handed = n.handed * decay + 1.0f;
+    n.forwarded = n.forwarded * decay + (forwarded ? 1.0f : 0.0f);
+    n.updated = std::max(n.updated, now);
+
+    if (!n.flagged && n.handed >= m_params.minEvidence &&
+        n.forwarded < m_params.threshold * n.handed)
+    {
+        n.flagged = true;
+        m_flags.push_back({m.node, node, Seconds(now)});
+        if (!m_flagCallback.IsNull())
+            m_flagCallback(m.node, node);
+    }
+}
+
+inline void
+WatchdogDetector::Finish()
+{
+    // Only entries whose deadline passed inside the run count as drops
+    double now = Simulator::Now().GetSeconds();
+    for (Monitor &m : m_monitors)
+        Expire(m, now);
+}
+
+inline void
+WatchdogDetector::PrintSummary(int32_t maliciousNode, Time activation, Time deadline) const
+{
+    Time firstDetection = Time::Max();
+    uint32_t detectors = 0;
+    uint32_t falsePositives = 0;
+    std::vector<bool> accused(m_monitors.size(), false);
+
+    for (const Flag &f : m_flags)
+    {
+        bool correct = int32_t(f.accused) == maliciousNode && f.time >= activation;
+        if (correct)
+        {
+            firstDetection = Min(firstDetection, f.time);
+            ++detectors;
+        }
+        else
+        {
+            ++falsePositives;
+            accused[f.accused] = true;
+        }
+    }
+
+    uint32_t falselyAccused = 0;
+    for (bool a : accused)
+        falselyAccused += a;
+
+    std::cout << "\n===== WATCHDOG DETECTION =====\n";
+    std::cout << "Frames inspected: " << m_frames << "\n";
+    std::cout << "Hand-overs watched: " << m_handed << " (" << m_confirmed << " forwarded, "
+              << m_expired << " not overheard, " << m_overflow << " ring overflow)\n";
+
+    if (maliciousNode >= 0)
+    {
+        if (firstDetection == Time::Max())
+        {
+            std::cout << "Malicious node " << maliciousNode << ": not detected\n";
+        }
+        else
+        {
+            Time latency = firstDetection - activation;
+            std::cout << "Malicious node " << maliciousNode << ": detected after "
+                      << latency.GetSeconds() << " s by " << detectors << " node(s)"
+                      << (latency <= deadline ? "" : " (later than the deadline)") << "\n";
+        }
+    }
+    std::cout << "False positives: " << falsePositives << " flags against "
+              << falselyAccused << " node(s)\n";
+    std::cout << "CPU per frame: " << (m_frames ? m_cpuNs / m_frames : 0.0) << " ns\n";
+    std::cout << "==============================\n";
+}
+
+} // namespace ns3
+
+#endif /* WATCHDOG_DETECTOR_H */
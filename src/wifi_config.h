@@ -0,0 +1,102 @@
+#ifndef WIFI_CONFIG_H
+#define WIFI_CONFIG_H
+
+#include "ns3/core-module.h"
+#include "ns3/wifi-module.h"
+
+#include <iostream>
+
+namespace ns3
+{
+
+/*
+ Wi-Fi standard and rate control selection
+ - standard: b (11 Mbps DSSS, 2.4 GHz, 22 MHz), g (54 Mbps ERP-OFDM,
+   2.4 GHz, 20 MHz), n (HT, 2.4 GHz, 20 MHz) or ac (VHT, 5 GHz, 80 MHz).
+   The band and width are set explicitly as the PHY's default
+   ChannelSettings: left unspecified, ns-3 would put n on 5 GHz, where
+   the ERP-OFDM control rate does not exist. ac has no 2.4 GHz band, so
+   its results include the band change
+ - rateControl:
+     default     keep WifiHelper's station manager
+     ideal       IdealWifiManager (SNR-driven, no probing)
+     minstrel-ht MinstrelHtWifiManager; b/g have no HT rates, so they
+                 get the legacy MinstrelWifiManager
+     constant    ConstantRateWifiManager at dataMode (empty = the
+                 standard's top single-stream rate), control frames at
+                 the standard's basic rate
+*/
+struct WifiStandardInfo
+{
+    WifiStandard standard;
+    const char *topMode;      // constant-rate default data mode
+    const char *controlMode;  // constant-rate control mode
+    bool ht;                  // has HT/VHT rates (Minstrel-HT applies)
+    const char *channel;      // WifiPhy::ChannelSettings {number, width, band, primary20}
+    const char *band;         // for the run log
+};
+
+inline WifiStandardInfo
+GetWifiStandardInfo(const std::string &standard)
+{
+    if (standard == "b")
+        return {WIFI_STANDARD_80211b, "DsssRate11Mbps", "DsssRate1Mbps", false,
+                "{0, 22, BAND_2_4GHZ, 0}", "2.4 GHz, 22 MHz"};
+    if (standard == "g")
+        return {WIFI_STANDARD_80211g, "ErpOfdmRate54Mbps", "ErpOfdmRate6Mbps", false,
+                "{0, 20, BAND_2_4GHZ, 0}", "2.4 GHz, 20 MHz"};
+    if (standard == "n")
+        return {WIFI_STANDARD_80211n, "HtMcs7", "ErpOfdmRate6Mbps", true,
+                "{0, 20, BAND_2_4GHZ, 0}", "2.4 GHz, 20 MHz"};
+    if (standard == "ac")
+        return {WIFI_STANDARD_80211ac, "VhtMcs9", "OfdmRate6Mbps", true,
+                "{0, 80, BAND_5GHZ, 0}", "5 GHz, 80 MHz"};
+
+    NS_ABORT_MSG("Unknown Wi-Fi standard " << standard << " (b, g, n or ac)");
+    return {};
+}
+
+inline void
+ConfigureWifi(WifiHelper &wifi,
+              const std::string &standard,
+              const std::string &rateControl,
+              const std::string &dataMode = "")
+{
+    WifiStandardInfo info = GetWifiStandardInfo(standard);
+    wifi.SetStandard(info.standard);
+    // Picked up by every PHY the helpers create after this call
+    Config::SetDefault("ns3::WifiPhy::ChannelSettings", StringValue(info.channel));
+
+    if (rateControl == "ideal")
+    {
+        wifi.SetRemoteStationManager("ns3::IdealWifiManager");
+    }
+    else if (rateControl == "minstrel-ht")
+    {
+        wifi.SetRemoteStationManager(info.ht ? "ns3::MinstrelHtWifiManager"
+                                             : "ns3::MinstrelWifiManager");
+    }
+    else if (rateControl == "constant")
+    {
+        std::string mode = dataMode.empty() ? info.topMode : dataMode;
+        wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                     "DataMode", StringValue(mode),
+                                     "ControlMode", StringValue(info.controlMode));
+    }
+    else
+    {
+        NS_ABORT_MSG_IF(rateControl != "default",
+                        "Unknown rate control " << rateControl
+                                                << " (default, ideal, minstrel-ht or constant)");
+    }
+
+    std::cout << "[INFO] Wi-Fi 802.11" << standard << " (" << info.band << "), rate control "
+              << rateControl;
+    if (rateControl == "constant")
+        std::cout << " (" << (dataMode.empty() ? info.topMode : dataMode) << ")";
+    std::cout << "\n";
+}
+
+} // namespace ns3
+
+#endif /* WIFI_CONFIG_H */
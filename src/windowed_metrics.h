@@ -0,0 +1,315 @@
+#ifndef WINDOWED_METRICS_H
+#define WINDOWED_METRICS_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+namespace ns3
+{
+
+/*
+ Sliding-window PDR / delay / throughput
+ - Hooks Ipv4L3Protocol SendOutgoing (at the origin) and LocalDeliver
+   (at the destination) on every node, the same points FlowMonitor's
+   probes use. Only UDP packets from/to Port are counted, so routing
+   control traffic is excluded
+ - Send times live in a fixed ring indexed by packet uid, so a delivery
+   finds its delay with no map lookup and no allocation
+ - Packets are attributed to the window they were sent in. Windows sit
+   in a ring of bins until they are older than MaxDelay, then they are
+   written out and folded into the pre/post-attack summary
+ - Recovery time = start of the first post-attack window from which PDR
+   stays at or above RecoveryFraction of the pre-attack mean
+*/
+class WindowedMetrics
+{
+  public:
+    WindowedMetrics(Time window, Time attackTime, uint16_t port = 9,
+                    Time maxDelay = Seconds(5.0), uint32_t stampCapacity = 1 << 16);
+
+    // Connect to every node's Ipv4L3Protocol; call after the stack is installed
+    void Install();
+
+    // Optional CSV with one row per window
+    void SetOutput(const std::string &path);
+
+    // Forked sweeps: write out buffered rows before fork(), then, in the
+    // child, carry on in a copy of the file written so far
+    void Flush();
+    void ContinueAs(const std::string &path);
+
+    // Emit the remaining windows; call after Simulator::Run()
+    void Finish();
+
+    void PrintSummary() const;
+
+    void SetRecoveryFraction(double fraction) { m_recoveryFraction = fraction; }
+
+    // Seconds after the attack until PDR recovered: 0 if it never
+    // degraded, negative if it did not recover. Valid after Finish()
+    double GetRecoveryTime() const
+    {
+        if (m_firstDegraded < 0)
+            return 0.0;
+        return m_recoveredAt < 0 ? -1.0 : m_recoveredAt - m_attackTime.GetSeconds();
+    }
+
+  private:
+    struct Bin
+    {
+        int64_t index = -1;
+        uint32_t tx = 0;
+        uint32_t rx = 0;
+        uint64_t rxBytes = 0;
+        double delaySum = 0.0;
+    };
+
+    struct Stamp
+    {
+        uint64_t uid = ~uint64_t(0);
+        int64_t window = 0;
+        Time sent;
+    };
+
+    bool IsCounted(const Ipv4Header &header, Ptr<const Packet> packet) const;
+    void Sent(const Ipv4Header &header, Ptr<const Packet> packet, uint32_t interface);
+    void Delivered(const Ipv4Header &header, Ptr<const Packet> packet, uint32_t interface);
+    void AdvanceTo(int64_t window);
+    void Emit(const Bin &bin);
+
+    Time m_window;
+    Time m_attackTime;
+    uint16_t m_port;
+    double m_recoveryFraction = 0.9;
+
+    std::vector<Bin> m_bins;
+    std::vector<Stamp> m_stamps;
+    uint64_t m_stampMask;
+    int64_t m_newest = -1;
+    int64_t m_oldest = 0;
+    uint64_t m_late = 0;
+
+    std::ofstream m_out;
+    std::string m_path;
+
+    // Running summary
+    double m_prePdrSum = 0.0;
+    uint32_t m_preWindows = 0;
+    double m_postPdrSum = 0.0;
+    uint32_t m_postWindows = 0;
+    double m_minPostPdr = 100.0;
+    double m_firstDegraded = -1.0;
+    double m_recoveredAt = -1.0;
+};
+
+inline
+WindowedMetrics::WindowedMetrics(Time window, Time attackTime, uint16_t port,
+                                 Time maxDelay, uint32_t stampCapacity)
+    : m_window(window),
+      m_attackTime(attackTime),
+      m_port(port)
+{
+    NS_ABORT_MSG_IF(stampCapacity & (stampCapacity - 1), "Stamp capacity must be a power of two");
+
+    m_bins.resize(std::ceil(maxDelay.GetSeconds() / window.GetSeconds()) + 1);
+    m_stamps.resize(stampCapacity);
+    m_stampMask = stampCapacity - 1;
+}
+
+inline void
+WindowedMetrics::Install()
+{
+    Config::ConnectWithoutContext("/NodeList/*/$ns3::Ipv4L3Protocol/SendOutgoing",
+                                  MakeCallback(&WindowedMetrics::Sent, this));
+    Config::ConnectWithoutContext("/NodeList/*/$ns3::Ipv4L3Protocol/LocalDeliver",
+                                  MakeCallback(&WindowedMetrics::Delivered, this));
+}
+
+inline void
+WindowedMetrics::SetOutput(const std::string &path)
+{
+    m_out.open(path);
+    NS_ABORT_MSG_IF(!m_out, "Cannot open " << path);
+    m_out << "windowStart,txPackets,rxPackets,pdr,avgDelay,throughputKbps\n";
+    m_path = path;
+}
+
+inline void
+WindowedMetrics::Flush()
+{
+    if (m_out.is_open())
+        m_out.flush();
+}
+
+inline void
+WindowedMetrics::ContinueAs(const std::string &path)
+{
+    if (!m_out.is_open())
+        return;
+
+    m_out.close();
+    {
+        std::ifstream in(m_path, std::ios::binary);
+        std::ofstream out(path, std::ios::binary);
+        NS_ABORT_MSG_IF(!out, "Cannot open " << path);
+        out << in.rdbuf();
+    }
+    m_out.open(path, std::ios::app);
+    m_path = path;
+}
+
+inline bool
+WindowedMetrics::IsCounted(const Ipv4Header &header, Ptr<const Packet> packet) const
+{
+    if (header.GetProtocol() != UdpL4Protocol::PROT_NUMBER)
+        return false;
+
+    UdpHeader udp;
+    packet->PeekHeader(udp);
+    return udp.GetDestinationPort() == m_port || udp.GetSourcePort() == m_port;
+}
+
+inline void
+WindowedMetrics::Sent(const Ipv4Header &header, Ptr<const Packet> packet, uint32_t)
+{
+    if (!IsCounted(header, packet))
+        return;
+
+    Time now = Simulator::Now();
+    int64_t window = now.GetInteger() / m_window.GetInteger();
+    AdvanceTo(window);
+
+    m_bins[window % m_bins.size()].tx++;
+
+    Stamp &stamp = m_stamps[packet->GetUid() & m_stampMask];
+    stamp.uid = packet->GetUid();
+    stamp.window = window;
+    stamp.sent = now;
+}
+
+inline void
+WindowedMetrics::Delivered(const Ipv4Header &header, Ptr<const Packet> packet, uint32_t)
+{
+    if (!IsCounted(header, packet))
+        return;
+
+    const Stamp &stamp = m_stamps[packet->GetUid() & m_stampMask];
+    if (stamp.uid != packet->GetUid() || stamp.window < m_oldest)
+    {
+        ++m_late;   // overwritten stamp or window already emitted
+        return;
+    }
+
+    Bin &bin = m_bins[stamp.window % m_bins.size()];
+    bin.rx++;
+    bin.rxBytes += packet->GetSize() + header.GetSerializedSize();
+    bin.delaySum += (Simulator::Now() - stamp.sent).GetSeconds();
+}
+
+inline void
+WindowedMetrics::AdvanceTo(int64_t window)
+{
+    if (window <= m_newest)
+        return;
+
+    for (int64_t w = m_newest + 1; w <= window; ++w)
+    {
+        Bin &bin = m_bins[w % m_bins.size()];
+        if (bin.index >= 0)
+        {
+            Emit(bin);
+            m_oldest = bin.index + 1;
+        }
+        bin = Bin();
+        bin.index = w;
+    }
+    m_newest = window;
+}
+
+inline void
+WindowedMetrics::Emit(const Bin &bin)
+{
+    if (bin.tx == 0)
+        return;
+
+    double start = bin.index * m_window.GetSeconds();
+    double end = start + m_window.GetSeconds();
+    double pdr = 100.0 * bin.rx / bin.tx;
+    double avgDelay = bin.rx > 0 ? bin.delaySum / bin.rx : 0.0;
+    double throughput = bin.rxBytes * 8.0 / m_window.GetSeconds() / 1000.0;
+
+    if (m_out.is_open())
+    {
+        m_out << start << ',' << bin.tx << ',' << bin.rx << ',' << pdr << ','
+              << avgDelay << ',' << throughput << '\n';
+    }
+
+    double attack = m_attackTime.GetSeconds();
+    if (end <= attack)
+    {
+        m_prePdrSum += pdr;
+        ++m_preWindows;
+        return;
+    }
+    if (start < attack)
+        return;   // straddles the attack
+
+    m_postPdrSum += pdr;
+    ++m_postWindows;
+    m_minPostPdr = std::min(m_minPostPdr, pdr);
+
+    double target = m_recoveryFraction * (m_preWindows ? m_prePdrSum / m_preWindows : 100.0);
+    if (pdr < target)
+    {
+        if (m_firstDegraded < 0)
+            m_firstDegraded = start;
+        m_recoveredAt = -1.0;
+    }
+    else if (m_firstDegraded >= 0 && m_recoveredAt < 0)
+    {
+        m_recoveredAt = start;
+    }
+}
+
+inline void
+WindowedMetrics::Finish()
+{
+    AdvanceTo(m_newest + m_bins.size());
+    if (m_out.is_open())
+        m_out.close();
+}
+
+inline void
+WindowedMetrics::PrintSummary() const
+{
+    double attack = m_attackTime.GetSeconds();
+
+    std::cout << "\n===== WINDOWED METRICS (" << m_window.GetSeconds() << " s) =====\n";
+    std::cout << "Pre-attack PDR: "
+              << (m_preWindows ? m_prePdrSum / m_preWindows : 0.0) << " %\n";
+    std::cout << "Post-attack PDR: "
+              << (m_postWindows ? m_postPdrSum / m_postWindows : 0.0) << " %\n";
+    std::cout << "Worst post-attack window PDR: " << m_minPostPdr << " %\n";
+
+    if (m_firstDegraded < 0)
+        std::cout << "Degradation: none below " << m_recoveryFraction * 100 << "% of pre-attack\n";
+    else
+        std::cout << "Degradation onset: " << m_firstDegraded - attack << " s after attack\n";
+
+    if (m_firstDegraded >= 0 && m_recoveredAt >= 0)
+        std::cout << "Recovery time: " << m_recoveredAt - attack << " s after attack\n";
+    else if (m_firstDegraded >= 0)
+        std::cout << "Recovery time: not recovered\n";
+
+    std::cout << "Late deliveries (uncounted): " << m_late << "\n";
+    std::cout << "=====================================\n";
+}
+
+} // namespace ns3
+
+#endif /* WINDOWED_METRICS_H */